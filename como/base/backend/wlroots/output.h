@@ -133,6 +133,8 @@ public:
     {
         wl_list_remove(&destroy_rec.event.link);
         if (native) {
+            // The render output is destroyed later but wlroots destroys its cursor with the output.
+            get_render(this->render)->cursor.reset();
             wlr_output_destroy(native);
         }
         if (backend) {
@@ -10,6 +10,7 @@
 
 #include <QRect>
 #include <xcb/composite.h>
+#include <xcb/shape.h>
 #include <xcb/xcb.h>
 
 namespace como::base::x11::xcb
@@ -109,6 +110,8 @@ XCB_WRAPPER(overlay_window, xcb_composite_get_overlay_window, xcb_window_t)
 
 XCB_WRAPPER(pointer, xcb_query_pointer, xcb_window_t)
 
+XCB_WRAPPER(shape_extents, xcb_shape_query_extents, xcb_window_t)
+
 struct query_keymap_data
     : public wrapper_data<xcb_query_keymap_reply_t, xcb_query_keymap_cookie_t> {
     static constexpr request_func requestFunc = &xcb_query_keymap_unchecked;
@@ -78,9 +78,17 @@ void cursor::kglobal_settings_notify_change(int type, int arg)
 {
     Q_UNUSED(arg)
     if (type == 5 /*CursorChanged*/) {
+        auto const old_name = m_themeName;
+        auto const old_size = m_themeSize;
+
         config->reparseConfiguration();
         load_theme_from_kconfig();
 
+        if (m_themeName == old_name && m_themeSize == old_size) {
+            // The theme itself might have been installed or updated.
+            Q_EMIT theme_changed();
+        }
+
         // sync to environment
         qputenv("XCURSOR_THEME", m_themeName.toUtf8());
         qputenv("XCURSOR_SIZE", QByteArray::number(m_themeSize));
@@ -123,6 +123,8 @@ Q_SIGNALS:
      * @see stop_image_tracking
      */
     void image_changed();
+
+    /// Emitted when the theme changes or the theme configuration is reloaded.
     void theme_changed();
 
 protected:
@@ -99,6 +99,21 @@ protected:
                             &cursor::image_changed);
     }
 
+    // Hiding and showing changes what must be rendered like an image change does.
+    void do_hide() override
+    {
+        if (is_image_tracking()) {
+            Q_EMIT image_changed();
+        }
+    }
+
+    void do_show() override
+    {
+        if (is_image_tracking()) {
+            Q_EMIT image_changed();
+        }
+    }
+
 private:
     Qt::KeyboardModifiers get_keyboard_modifiers()
     {
@@ -74,8 +74,10 @@ public:
                              [this] { reevaluteSource(); });
         }
 
-        QObject::connect(
-            &cursor, &Cursor::theme_changed, qobject.get(), [this] { m_cursorTheme = {}; });
+        QObject::connect(&cursor, &Cursor::theme_changed, qobject.get(), [this] {
+            xcursor_theme::clear_cache();
+            m_cursorTheme = {};
+        });
         QObject::connect(redirect.platform.base.qobject.get(),
                          &Cursor::redirect_t::platform_t::base_t::qobject_t::topology_changed,
                          qobject.get(),
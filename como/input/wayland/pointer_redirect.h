@@ -25,6 +25,7 @@
 #include <Wrapland/Server/pointer_pool.h>
 #include <Wrapland/Server/seat.h>
 #include <Wrapland/Server/touch_pool.h>
+#include <optional>
 
 namespace como::input::wayland
 {
@@ -63,6 +64,7 @@ public:
         : qobject{std::make_unique<QObject>()}
         , redirect{redirect}
         , motions{*this}
+        , coalesce_motions{qEnvironmentVariableIsSet("KWIN_INPUT_COALESCE_MOTION")}
     {
     }
 
@@ -376,6 +378,29 @@ public:
     }
 
     void process_motion(motion_event const& event)
+    {
+        if (coalesce_motions && !constraints.locked && !constraints.confined) {
+            coalesce_motion(event);
+            return;
+        }
+
+        flush_motion();
+        dispatch_motion(event);
+    }
+
+    /// Dispatches relative motion accumulated since the last dispatch.
+    void flush_motion()
+    {
+        if (!pending_motion) {
+            return;
+        }
+
+        auto const event = *pending_motion;
+        pending_motion.reset();
+        dispatch_motion(event);
+    }
+
+    void dispatch_motion(motion_event const& event)
     {
         if (motions.is_locked()) {
             motions.schedule(event.delta, event.unaccel_delta, event.base.time_msec);
@@ -398,6 +423,8 @@ public:
 
     void process_motion_absolute(motion_absolute_event const& event)
     {
+        flush_motion();
+
         if (motions.is_locked()) {
             motions.schedule(event.pos, event.base.time_msec);
             return;
@@ -434,6 +461,8 @@ public:
 
     void process_button(button_event const& event)
     {
+        flush_motion();
+
         if (event.state == button_state::pressed) {
             // Check focus before processing spies/filters.
             device_redirect_update(this);
@@ -454,6 +483,8 @@ public:
 
     void process_axis(axis_event const& event)
     {
+        flush_motion();
+
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
@@ -466,6 +497,8 @@ public:
 
     void process_swipe_begin(swipe_begin_event const& event)
     {
+        flush_motion();
+
         process_spies(redirect->m_spies,
                       std::bind(&event_spy<Redirect>::swipe_begin, std::placeholders::_1, event));
         process_filters(
@@ -497,6 +530,8 @@ public:
 
     void process_pinch_begin(pinch_begin_event const& event)
     {
+        flush_motion();
+
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
@@ -530,6 +565,8 @@ public:
 
     void process_hold_begin(hold_begin_event const& event)
     {
+        flush_motion();
+
         device_redirect_update(this);
 
         process_spies(redirect->m_spies,
@@ -993,6 +1030,27 @@ private:
     } constraints;
 
     motion_scheduler<pointer_redirect> motions;
+
+    /// Accumulates relative motion and dispatches it once the current batch of input events from
+    /// the event loop has been processed.
+    void coalesce_motion(motion_event const& event)
+    {
+        if (pending_motion) {
+            pending_motion->delta += event.delta;
+            pending_motion->unaccel_delta += event.unaccel_delta;
+            pending_motion->base = event.base;
+            return;
+        }
+
+        pending_motion = event;
+        QMetaObject::invokeMethod(
+            qobject.get(), [this] { flush_motion(); }, Qt::QueuedConnection);
+    }
+
+    // Relative motion is not coalesced while the pointer is locked or confined, so that clients
+    // consuming relative motion through a pointer constraint still receive every event.
+    bool coalesce_motions;
+    std::optional<motion_event> pending_motion;
 };
 
 }
@@ -37,6 +37,7 @@
 #include <como/input/redirect_qobject.h>
 #include <como/input/spies/activity.h>
 #include <como/input/spies/touch_hide_cursor.h>
+#include <como/input/window_index.h>
 
 #include <KConfigWatcher>
 #include <Wrapland/Server/display.h>
@@ -70,6 +71,7 @@ public:
         , input_method{std::make_unique<wayland::input_method<type>>(*this)}
         , tablet_mode_manager{std::make_unique<dbus::tablet_mode_manager<type>>(*this)}
     {
+        window_index = std::make_unique<input::window_index<Space>>(space);
         setup_workspace();
 
         using base_t = std::decay_t<decltype(platform.base)>;
@@ -232,6 +234,9 @@ public:
 
     std::unique_ptr<input::dpms_filter<type>> dpms_filter;
 
+    /// Narrows down the windows to test when looking for the window at a position.
+    std::unique_ptr<input::window_index<Space>> window_index;
+
     std::unique_ptr<redirect_qobject> qobject;
     platform_t& platform;
     Space& space;
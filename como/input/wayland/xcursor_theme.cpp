@@ -5,8 +5,6 @@
 */
 #include "xcursor_theme.h"
 
-#include <como/input/extern/xcursor.h>
-
 #include <KConfig>
 #include <KConfigGroup>
 #include <QDir>
@@ -15,6 +13,10 @@
 #include <QSharedData>
 #include <QStack>
 #include <QStandardPaths>
+#include <QtEndian>
+#include <algorithm>
+#include <deque>
+#include <optional>
 
 namespace como::input::wayland
 {
@@ -30,10 +32,20 @@ public:
 class xcursor_theme_private : public QSharedData
 {
 public:
-    void load(QString const& name, int size, double device_pixel_ratio);
-    void load_cursors(QString const& package_path, int size, double device_pixel_ratio);
+    void load(QString const& name);
+    QList<xcursor_sprite> shape(QByteArray const& name) const;
+
+    int size{0};
+    double device_pixel_ratio{1.};
+
+    /// Cursor directories of the theme and its inherited themes in lookup order.
+    QStringList directories;
 
-    QHash<QByteArray, QList<xcursor_sprite>> registry;
+    /// Shapes are loaded on first request. Unknown shapes are stored with an empty list.
+    mutable QHash<QByteArray, QList<xcursor_sprite>> registry;
+
+    /// Sprites by canonical file path, so shapes that are symlinks to the same file share them.
+    mutable QHash<QString, QList<xcursor_sprite>> files;
 };
 
 xcursor_sprite::xcursor_sprite()
@@ -79,65 +91,177 @@ std::chrono::milliseconds xcursor_sprite::delay() const
     return d_ptr->delay;
 }
 
-static QList<xcursor_sprite>
-load_cursor(QString const& file_path, int target_size, double device_pixel_ratio)
+namespace
+{
+
+constexpr uint32_t xcursor_magic{0x72756358};
+constexpr uint32_t xcursor_image_type{0xfffd0002};
+constexpr uint32_t xcursor_image_max_size{0x7fff};
+constexpr size_t xcursor_file_header_size{4 * 4};
+constexpr size_t xcursor_toc_size{3 * 4};
+constexpr size_t xcursor_image_header_size{9 * 4};
+
+/// Reads the Xcursor file format (see Xcursor(3)) from a memory-mapped file.
+class xcursor_file_reader
 {
-    auto images
-        = XcursorFileLoadImages(QFile::encodeName(file_path), target_size * device_pixel_ratio);
-    if (!images) {
-        return {};
+public:
+    explicit xcursor_file_reader(QString const& path)
+        : file{path}
+    {
+        if (!file.open(QIODevice::ReadOnly) || file.size() < qint64(xcursor_file_header_size)) {
+            return;
+        }
+        data = file.map(0, file.size());
+        size = data ? static_cast<size_t>(file.size()) : 0;
     }
 
-    QList<xcursor_sprite> sprites;
+    /// Decodes the images of the nominal size closest to @p target_size.
+    QList<xcursor_sprite> load(int target_size, double device_pixel_ratio) const
+    {
+        if (!data || uint_at(0) != xcursor_magic) {
+            return {};
+        }
+
+        size_t const header = uint_at(4);
+        auto const ntoc = uint_at(12);
+        if (header < xcursor_file_header_size || header > size
+            || (size - header) / xcursor_toc_size < ntoc) {
+            return {};
+        }
+
+        auto const nominal = static_cast<uint32_t>(target_size * device_pixel_ratio);
+        auto const toc = [&](uint32_t index, size_t field) {
+            return uint_at(header + index * xcursor_toc_size + field * 4);
+        };
+        auto const toc_type = [&](uint32_t index) { return toc(index, 0); };
+        auto const toc_size = [&](uint32_t index) { return toc(index, 1); };
+        auto const dist = [](uint32_t a, uint32_t b) { return a > b ? a - b : b - a; };
+
+        uint32_t best_size{0};
+        for (uint32_t index = 0; index < ntoc; ++index) {
+            if (toc_type(index) != xcursor_image_type) {
+                continue;
+            }
+            auto const image_size = toc_size(index);
+            if (!best_size || dist(image_size, nominal) < dist(best_size, nominal)) {
+                best_size = image_size;
+            }
+        }
+        if (!best_size) {
+            return {};
+        }
+
+        QList<xcursor_sprite> sprites;
 
-    for (int i = 0; i < images->nimage; ++i) {
-        auto const* nativeCursorImage = images->images[i];
-        auto const scale = std::max(1., static_cast<double>(nativeCursorImage->size) / target_size);
-        QPoint const hotspot(nativeCursorImage->xhot, nativeCursorImage->yhot);
-        std::chrono::milliseconds const delay(nativeCursorImage->delay);
+        for (uint32_t index = 0; index < ntoc; ++index) {
+            if (toc_type(index) != xcursor_image_type || toc_size(index) != best_size) {
+                continue;
+            }
+            auto sprite = load_image(toc(index, 2), target_size);
+            if (!sprite) {
+                // Like libXcursor, discard the cursor if any of its frames is corrupt.
+                return {};
+            }
+            sprites.append(*sprite);
+        }
+
+        return sprites;
+    }
+
+private:
+    std::optional<xcursor_sprite> load_image(size_t position, int target_size) const
+    {
+        if (position > size || size - position < xcursor_image_header_size) {
+            return {};
+        }
+
+        auto const nominal = uint_at(position + 8);
+        auto const width = uint_at(position + 16);
+        auto const height = uint_at(position + 20);
+        auto const xhot = uint_at(position + 24);
+        auto const yhot = uint_at(position + 28);
+        std::chrono::milliseconds const delay(uint_at(position + 32));
+
+        if (uint_at(position + 4) != xcursor_image_type) {
+            return {};
+        }
+        if (width == 0 || height == 0 || width > xcursor_image_max_size
+            || height > xcursor_image_max_size || xhot > width || yhot > height) {
+            return {};
+        }
+
+        auto const pixels = position + xcursor_image_header_size;
+        auto const pixel_count = static_cast<size_t>(width) * height;
+        if ((size - pixels) / 4 < pixel_count) {
+            return {};
+        }
+
+        QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+        if (image.isNull()) {
+            return {};
+        }
+
+        // Pixels are stored as little-endian ARGB32 values. Only the frames of the selected size
+        // are touched, so pages of other sizes are never read from the mapping.
+        auto const stride = static_cast<size_t>(width) * 4;
+        for (uint32_t row = 0; row < height; ++row) {
+            qFromLittleEndian<uint32_t>(data + pixels + row * stride, width, image.scanLine(row));
+        }
 
-        QImage data(nativeCursorImage->width,
-                    nativeCursorImage->height,
-                    QImage::Format_ARGB32_Premultiplied);
-        data.setDevicePixelRatio(scale);
-        memcpy(data.bits(), nativeCursorImage->pixels, data.sizeInBytes());
+        auto const scale = std::max(1., static_cast<double>(nominal) / target_size);
+        image.setDevicePixelRatio(scale);
 
-        sprites.append(xcursor_sprite(data, hotspot / scale, delay));
+        return xcursor_sprite(image, QPoint(xhot, yhot) / scale, delay);
     }
 
-    XcursorImagesDestroy(images);
-    return sprites;
+    /// The caller must make sure that the value lies inside the mapping.
+    uint32_t uint_at(size_t offset) const
+    {
+        return qFromLittleEndian<uint32_t>(data + offset);
+    }
+
+    QFile file;
+    uchar* data{nullptr};
+    size_t size{0};
+};
+
+}
+
+QList<xcursor_sprite>
+load_xcursor_file(QString const& path, int target_size, double device_pixel_ratio)
+{
+    return xcursor_file_reader(path).load(target_size, device_pixel_ratio);
 }
 
-void xcursor_theme_private::load_cursors(QString const& package_path,
-                                         int size,
-                                         double device_pixel_ratio)
+QList<xcursor_sprite> xcursor_theme_private::shape(QByteArray const& name) const
 {
-    QDir const dir(package_path);
-    auto entries = dir.entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
-    std::partition(
-        entries.begin(), entries.end(), [](auto const& info) { return !info.isSymLink(); });
-
-    for (auto const& entry : std::as_const(entries)) {
-        auto const shape = QFile::encodeName(entry.fileName());
-        if (registry.contains(shape)) {
+    if (auto it = registry.constFind(name); it != registry.constEnd()) {
+        return *it;
+    }
+
+    QList<xcursor_sprite> sprites;
+
+    for (auto const& dir : directories) {
+        QFileInfo const info(dir + QLatin1Char('/') + QFile::decodeName(name));
+        if (!info.isFile()) {
             continue;
         }
-        if (entry.isSymLink()) {
-            QFileInfo const symLinkInfo(entry.symLinkTarget());
-            if (symLinkInfo.absolutePath() == entry.absolutePath()) {
-                auto const sprites = registry.value(QFile::encodeName(symLinkInfo.fileName()));
-                if (!sprites.isEmpty()) {
-                    registry.insert(shape, sprites);
-                    continue;
-                }
-            }
+
+        auto const path = info.canonicalFilePath();
+        if (auto it = files.constFind(path); it != files.constEnd()) {
+            sprites = *it;
+        } else {
+            sprites = load_xcursor_file(path, size, device_pixel_ratio);
+            files.insert(path, sprites);
         }
-        auto const sprites = load_cursor(entry.absoluteFilePath(), size, device_pixel_ratio);
+
         if (!sprites.isEmpty()) {
-            registry.insert(shape, sprites);
+            break;
         }
     }
+
+    registry.insert(name, sprites);
+    return sprites;
 }
 
 static QStringList search_paths()
@@ -164,7 +288,7 @@ static QStringList search_paths()
     return paths;
 }
 
-void xcursor_theme_private::load(QString const& name, int size, double device_pixel_ratio)
+void xcursor_theme_private::load(QString const& name)
 {
     auto const paths = search_paths();
     bool default_fallback = false;
@@ -186,7 +310,9 @@ void xcursor_theme_private::load(QString const& name, int size, double device_pi
             if (!dir.exists()) {
                 continue;
             }
-            load_cursors(dir.filePath(QStringLiteral("cursors")), size, device_pixel_ratio);
+            if (dir.exists(QStringLiteral("cursors"))) {
+                directories.append(dir.filePath(QStringLiteral("cursors")));
+            }
             if (inherits.isEmpty()) {
                 KConfig const config(dir.filePath(QStringLiteral("index.theme")),
                                      KConfig::NoGlobals);
@@ -200,7 +326,7 @@ void xcursor_theme_private::load(QString const& name, int size, double device_pi
             stack.push(*it);
         }
 
-        if (registry.empty() && name == "default" && !default_fallback) {
+        if (directories.empty() && name == "default" && !default_fallback) {
             // This is a last resort in case we haven't found any theme directly in a "cursors"
             // directory, through inherit of index.theme in standard paths or XCURSOR_PATH.
             // We aim for always having a theme because otherwise no cursor is painted.
@@ -211,15 +337,66 @@ void xcursor_theme_private::load(QString const& name, int size, double device_pi
     }
 }
 
+namespace
+{
+
+struct theme_cache_entry {
+    QString name;
+    int size;
+    double device_pixel_ratio;
+    QSharedDataPointer<xcursor_theme_private> theme;
+};
+
+std::deque<theme_cache_entry>& theme_cache()
+{
+    static std::deque<theme_cache_entry> cache;
+    return cache;
+}
+
+}
+
+/**
+ * Themes are shared between all users with the same name, size and scale. Shapes are only loaded
+ * on request, so a few recently used themes are kept around cheaply. This way switching back to
+ * a previous scale or theme does not load its shapes again.
+ */
+static QSharedDataPointer<xcursor_theme_private>
+get_theme(QString const& name, int size, double device_pixel_ratio)
+{
+    auto& cache = theme_cache();
+    constexpr size_t cache_size{4};
+
+    auto it = std::find_if(cache.begin(), cache.end(), [&](auto const& entry) {
+        return entry.name == name && entry.size == size
+            && qFuzzyCompare(entry.device_pixel_ratio, device_pixel_ratio);
+    });
+
+    if (it != cache.end()) {
+        std::rotate(cache.begin(), it, it + 1);
+        return cache.front().theme;
+    }
+
+    QSharedDataPointer<xcursor_theme_private> theme{new xcursor_theme_private};
+    theme->size = size;
+    theme->device_pixel_ratio = device_pixel_ratio;
+    theme->load(name);
+
+    cache.push_front({name, size, device_pixel_ratio, theme});
+    if (cache.size() > cache_size) {
+        cache.pop_back();
+    }
+
+    return theme;
+}
+
 xcursor_theme::xcursor_theme()
     : d_ptr{new xcursor_theme_private}
 {
 }
 
 xcursor_theme::xcursor_theme(QString const& name, int size, double device_pixel_ratio)
-    : d_ptr{new xcursor_theme_private}
+    : d_ptr{get_theme(name, size, device_pixel_ratio)}
 {
-    d_ptr->load(name, size, device_pixel_ratio);
 }
 
 xcursor_theme::xcursor_theme(xcursor_theme const& other)
@@ -249,12 +426,17 @@ bool xcursor_theme::operator!=(xcursor_theme const& other)
 
 bool xcursor_theme::empty() const
 {
-    return d_ptr->registry.isEmpty();
+    return d_ptr->directories.isEmpty();
 }
 
 QList<xcursor_sprite> xcursor_theme::shape(QByteArray const& name) const
 {
-    return d_ptr->registry.value(name);
+    return d_ptr->shape(name);
+}
+
+void xcursor_theme::clear_cache()
+{
+    theme_cache().clear();
 }
 
 }
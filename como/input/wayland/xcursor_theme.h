@@ -63,8 +63,21 @@ public:
 
     QList<xcursor_sprite> shape(QByteArray const& name) const;
 
+    /**
+     * Drops the themes kept for reuse. Themes created afterwards look up their directories and
+     * shapes again, so themes installed or updated in the meantime are picked up.
+     */
+    static void clear_cache();
+
 private:
     QSharedDataPointer<xcursor_theme_private> d_ptr;
 };
 
+/**
+ * Decodes the sprites of the Xcursor file at @p path with the nominal size closest to
+ * @p target_size scaled by @p device_pixel_ratio. Returns no sprites if the file is invalid.
+ */
+COMO_EXPORT QList<xcursor_sprite>
+load_xcursor_file(QString const& path, int target_size, double device_pixel_ratio);
+
 }
@@ -12,11 +12,70 @@
 namespace como::input
 {
 
+template<typename Win>
+bool controlled_window_accepts_input(Win* win, QPoint const& pos, bool screen_locked)
+{
+    if (win->remnant) {
+        // a deleted window doesn't get mouse events
+        return false;
+    }
+    if (win->control) {
+        if (!win::on_current_subspace(*win) || win->control->minimized) {
+            return false;
+        }
+    }
+    if (win->isHiddenInternal()) {
+        return false;
+    }
+    if (!win->render_data.ready_for_painting) {
+        return false;
+    }
+    if (screen_locked) {
+        auto show{false};
+
+        if constexpr (requires(Win* win) { win->isLockScreen(); }) {
+            show |= win->isLockScreen();
+        }
+        if constexpr (requires(Win* win) { win->isInputMethod(); }) {
+            show |= win->isInputMethod();
+        }
+        if (!show) {
+            return false;
+        }
+    }
+    return win::input_geometry(win).contains(pos) && win::wayland::accepts_input(win, pos);
+}
+
+template<typename Win>
+bool unmanaged_window_accepts_input(Win* win, QPoint const& pos)
+{
+    return !win->control && !win->remnant && win::input_geometry(win).contains(pos)
+        && win::wayland::accepts_input(win, pos);
+}
+
 template<typename Redirect>
 auto find_controlled_window(Redirect const& redirect, QPoint const& pos)
     -> std::optional<typename Redirect::window_t>
 {
     auto const isScreenLocked = win::wayland::screen_lock_is_locked(redirect.space);
+    auto accepts_input = [&](auto const& var_win) {
+        return std::visit(overload{[&](auto&& win) {
+                              return controlled_window_accepts_input(win, pos, isScreenLocked);
+                          }},
+                          var_win);
+    };
+
+    if constexpr (requires { redirect.window_index; }) {
+        if (auto candidates = redirect.window_index->stacked_at(pos)) {
+            for (auto const& win : *candidates) {
+                if (accepts_input(win)) {
+                    return win;
+                }
+            }
+            return {};
+        }
+    }
+
     auto const& stacking = redirect.space.stacking.order.stack;
     if (stacking.empty()) {
         return {};
@@ -26,41 +85,7 @@ auto find_controlled_window(Redirect const& redirect, QPoint const& pos)
 
     do {
         --it;
-
-        if (std::visit(overload{[&](auto&& win) {
-                           if (win->remnant) {
-                               // a deleted window doesn't get mouse events
-                               return false;
-                           }
-                           if (win->control) {
-                               if (!win::on_current_subspace(*win) || win->control->minimized) {
-                                   return false;
-                               }
-                           }
-                           if (win->isHiddenInternal()) {
-                               return false;
-                           }
-                           if (!win->render_data.ready_for_painting) {
-                               return false;
-                           }
-                           if (isScreenLocked) {
-                               auto show{false};
-                               using win_t = decltype(win);
-
-                               if constexpr (requires(win_t win) { win->isLockScreen(); }) {
-                                   show |= win->isLockScreen();
-                               }
-                               if constexpr (requires(win_t win) { win->isInputMethod(); }) {
-                                   show |= win->isInputMethod();
-                               }
-                               if (!show) {
-                                   return false;
-                               }
-                           }
-                           return win::input_geometry(win).contains(pos)
-                               && win::wayland::accepts_input(win, pos);
-                       }},
-                       *it)) {
+        if (accepts_input(*it)) {
             return *it;
         }
     } while (it != stacking.begin());
@@ -68,6 +93,36 @@ auto find_controlled_window(Redirect const& redirect, QPoint const& pos)
     return {};
 }
 
+template<typename Redirect>
+auto find_unmanaged_window(Redirect const& redirect, QPoint const& pos)
+    -> std::optional<typename Redirect::window_t>
+{
+    auto accepts_input = [&](auto const& var_win) {
+        return std::visit(
+            overload{[&](auto&& win) { return unmanaged_window_accepts_input(win, pos); }},
+            var_win);
+    };
+
+    if constexpr (requires { redirect.window_index; }) {
+        if (auto candidates = redirect.window_index->unmanaged_at(pos)) {
+            for (auto const& win : *candidates) {
+                if (accepts_input(win)) {
+                    return win;
+                }
+            }
+            return {};
+        }
+    }
+
+    for (auto const& win : redirect.space.windows) {
+        if (accepts_input(win)) {
+            return win;
+        }
+    }
+
+    return {};
+}
+
 template<typename Redirect>
 auto find_window(Redirect const& redirect, QPoint const& pos)
     -> std::optional<typename Redirect::window_t>
@@ -83,15 +138,8 @@ auto find_window(Redirect const& redirect, QPoint const& pos)
     }
 
     // Check windows without control (important for Xwayland unmanageds).
-    for (auto const& win : redirect.space.windows) {
-        if (std::visit(overload{[&](auto&& win) {
-                           return !win->control && !win->remnant
-                               && win::input_geometry(win).contains(pos)
-                               && win::wayland::accepts_input(win, pos);
-                       }},
-                       win)) {
-            return win;
-        }
+    if (auto win = find_unmanaged_window(redirect, pos)) {
+        return win;
     }
 
     return find_controlled_window(redirect, pos);
@@ -0,0 +1,257 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/base/platform_qobject.h>
+#include <como/utils/algorithm.h>
+#include <como/win/geo.h>
+#include <como/win/space_qobject.h>
+#include <como/win/stacking_order.h>
+#include <como/win/window_qobject.h>
+
+#include <QObject>
+#include <QRect>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace como::input
+{
+
+/**
+ * Grid over the output topology that holds in each cell the windows whose input geometry
+ * intersects the cell. It narrows down the windows to test when looking for the window at a
+ * position. Candidates must still be tested for their current state and exact input geometry.
+ *
+ * Windows are moved in the grid when their geometry changes. The grid is rebuilt lazily after
+ * the stacking order or the set of windows changed.
+ */
+template<typename Space>
+class window_index
+{
+public:
+    using window_t = typename Space::window_t;
+
+    static constexpr int cell_size{256};
+
+    explicit window_index(Space& space)
+        : qobject{std::make_unique<QObject>()}
+        , space{space}
+    {
+        auto invalidate = [this] { valid = false; };
+
+        QObject::connect(space.stacking.order.qobject.get(),
+                         &win::stacking_order_qobject::changed,
+                         qobject.get(),
+                         invalidate);
+
+        auto space_qobject = space.qobject.get();
+        QObject::connect(
+            space_qobject, &win::space_qobject::clientAdded, qobject.get(), invalidate);
+        QObject::connect(
+            space_qobject, &win::space_qobject::unmanagedAdded, qobject.get(), invalidate);
+        QObject::connect(
+            space_qobject, &win::space_qobject::wayland_window_added, qobject.get(), invalidate);
+        QObject::connect(
+            space_qobject, &win::space_qobject::internalClientAdded, qobject.get(), invalidate);
+
+        QObject::connect(space.base.qobject.get(),
+                         &base::platform_qobject::topology_changed,
+                         qobject.get(),
+                         invalidate);
+    }
+
+    ~window_index()
+    {
+        unwatch_all();
+    }
+
+    /**
+     * Windows in the stacking order whose input geometry might contain @p pos, topmost first.
+     * Returns @c nullptr when @p pos is outside of the indexed area.
+     */
+    std::vector<window_t> const* stacked_at(QPoint const& pos)
+    {
+        return get_cell(stacked, pos);
+    }
+
+    /**
+     * Windows without control whose input geometry might contain @p pos, in the order of the
+     * space's window list. Returns @c nullptr when @p pos is outside of the indexed area.
+     */
+    std::vector<window_t> const* unmanaged_at(QPoint const& pos)
+    {
+        return get_cell(unmanaged, pos);
+    }
+
+private:
+    struct entry {
+        size_t rank;
+        QRect geometry;
+    };
+
+    struct layer {
+        std::vector<std::vector<window_t>> cells;
+        std::unordered_map<window_t, entry> entries;
+    };
+
+    std::vector<window_t> const* get_cell(layer& grid, QPoint const& pos)
+    {
+        if (!valid) {
+            rebuild();
+        }
+        if (!area.contains(pos)) {
+            return nullptr;
+        }
+        return &grid.cells.at(cell_index(pos.x() / cell_size, pos.y() / cell_size));
+    }
+
+    size_t cell_index(int column, int row) const
+    {
+        return static_cast<size_t>(row) * columns + column;
+    }
+
+    template<typename Op>
+    void for_each_cell(QRect const& geometry, Op op)
+    {
+        auto const rect = geometry.intersected(area);
+        if (rect.isEmpty()) {
+            return;
+        }
+
+        for (int row = rect.top() / cell_size; row <= rect.bottom() / cell_size; row++) {
+            for (int column = rect.left() / cell_size; column <= rect.right() / cell_size;
+                 column++) {
+                op(cell_index(column, row));
+            }
+        }
+    }
+
+    void insert(layer& grid, window_t const& win, QRect const& geometry)
+    {
+        auto const rank = grid.entries.size();
+        grid.entries.insert({win, {rank, geometry}});
+        for_each_cell(geometry, [&](auto index) { grid.cells[index].push_back(win); });
+    }
+
+    void move(layer& grid, window_t const& win, QRect const& geometry)
+    {
+        auto it = grid.entries.find(win);
+        if (it == grid.entries.end() || it->second.geometry == geometry) {
+            return;
+        }
+
+        for_each_cell(it->second.geometry,
+                      [&](auto index) { remove_all(grid.cells[index], win); });
+
+        auto const rank = it->second.rank;
+        it->second.geometry = geometry;
+
+        // Keep the order of the cells by inserting in front of the first window with higher rank.
+        for_each_cell(geometry, [&](auto index) {
+            auto& cell = grid.cells[index];
+            auto pos = std::find_if(cell.begin(), cell.end(), [&](auto const& other) {
+                return grid.entries.at(other).rank > rank;
+            });
+            cell.insert(pos, win);
+        });
+    }
+
+    void rebuild()
+    {
+        unwatch_all();
+
+        auto const& size = space.base.topology.size;
+        area = QRect(QPoint(), size);
+        columns = (size.width() + cell_size - 1) / cell_size;
+        rows = (size.height() + cell_size - 1) / cell_size;
+
+        for (auto grid : {&stacked, &unmanaged}) {
+            grid->cells.assign(static_cast<size_t>(columns) * rows, {});
+            grid->entries.clear();
+        }
+
+        auto const& stack = space.stacking.order.stack;
+        for (auto it = stack.crbegin(); it != stack.crend(); ++it) {
+            std::visit(overload{[&, this](auto&& win) {
+                           if (win->remnant) {
+                               return;
+                           }
+                           watch(win);
+                           insert(stacked, *it, win::input_geometry(win));
+                       }},
+                       *it);
+        }
+
+        for (auto const& var_win : space.windows) {
+            std::visit(overload{[&, this](auto&& win) {
+                           if (win->control || win->remnant) {
+                               return;
+                           }
+                           watch(win);
+                           insert(unmanaged, var_win, win::input_geometry(win));
+                       }},
+                       var_win);
+        }
+
+        valid = true;
+    }
+
+    template<typename Win>
+    void watch(Win* win)
+    {
+        if (watched.contains(win)) {
+            return;
+        }
+
+        auto& connections = watched[win];
+        connections.geometry
+            = QObject::connect(win->qobject.get(),
+                               &win::window_qobject::frame_geometry_changed,
+                               qobject.get(),
+                               [this, win] {
+                                   if (!valid) {
+                                       return;
+                                   }
+                                   auto const geometry = win::input_geometry(win);
+                                   move(stacked, win, geometry);
+                                   move(unmanaged, win, geometry);
+                               });
+        connections.destroy = QObject::connect(win->qobject.get(),
+                                               &win::window_qobject::destroyed,
+                                               qobject.get(),
+                                               [this] { valid = false; });
+    }
+
+    void unwatch_all()
+    {
+        for (auto const& [win, connections] : watched) {
+            QObject::disconnect(connections.geometry);
+            QObject::disconnect(connections.destroy);
+        }
+        watched.clear();
+    }
+
+    struct notifiers {
+        QMetaObject::Connection geometry;
+        QMetaObject::Connection destroy;
+    };
+
+    std::unique_ptr<QObject> qobject;
+    Space& space;
+
+    bool valid{false};
+    QRect area;
+    int columns{0};
+    int rows{0};
+
+    layer stacked;
+    layer unmanaged;
+    std::unordered_map<window_t, notifiers> watched;
+};
+
+}
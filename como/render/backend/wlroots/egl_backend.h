@@ -10,6 +10,7 @@
 #include "egl_helpers.h"
 #include "egl_output.h"
 #include "egl_texture.h"
+#include "pbo_upload.h"
 #include "wlr_helpers.h"
 
 #include <como/render/gl/backend.h>
@@ -70,6 +71,8 @@ public:
         gl::init_buffer_age(*this);
         wayland::init_egl(*this, data);
 
+        pbo = pbo_upload::create();
+
         if (this->hasExtension(QByteArrayLiteral("EGL_EXT_image_dma_buf_import"))) {
             auto const formats_set = wlr_renderer_get_dmabuf_texture_formats(backend.renderer);
             auto const formats_map = get_drm_formats<Wrapland::Server::drm_format>(formats_set);
@@ -221,6 +224,43 @@ public:
         return region;
     }
 
+    bool direct_scanout(base::output* output, typename gl_scene::window_t& window) override
+    {
+        auto& out = get_egl_out(output);
+        auto const& output_impl = static_cast<typename Backend::output_t::base_t const&>(*output);
+
+        if (output_impl.transform() != base::wayland::output_transform::normal) {
+            return false;
+        }
+
+        return std::visit(
+            overload{[&](auto&& win) {
+                if constexpr (requires(decltype(win) win) { win->surface; }) {
+                    if (!win->surface || win->surface->state().source_rectangle.isValid()) {
+                        return false;
+                    }
+
+                    auto const& buffer = win->surface->state().buffer;
+                    if (!buffer) {
+                        return false;
+                    }
+
+                    auto dmabuf = buffer->linuxDmabufBuffer();
+                    if (!dmabuf || dmabuf->size != output_impl.mode_size()) {
+                        return false;
+                    }
+                    if (dmabuf->flags & Wrapland::Server::linux_dmabuf_flag_v1::y_inverted) {
+                        // Would need to be flipped on composition.
+                        return false;
+                    }
+
+                    return out->scanout(buffer, *dmabuf);
+                }
+                return false;
+            }},
+            *window.ref_win);
+    }
+
     void endRenderingFrameForScreen(base::output* output,
                                     QRegion const& renderedRegion,
                                     QRegion const& damagedRegion) override
@@ -298,9 +338,13 @@ public:
     GLFramebuffer native_fbo;
     wlr_egl* native{nullptr};
 
+    /// Uploads large damage of shm buffers asynchronously. Null if unsupported.
+    std::unique_ptr<pbo_upload> pbo;
+
 private:
     void cleanup()
     {
+        pbo.reset();
         cleanupGL();
         doneCurrent();
         cleanupSurfaces();
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "egl_helpers.h"
+#include "wlr_client_dmabuf_buffer.h"
 #include "wlr_includes.h"
 
 #include <como/base/logging.h>
@@ -15,6 +16,7 @@
 #include <como/render/gl/interface/utils.h>
 
 #include <QRegion>
+#include <Wrapland/Server/buffer.h>
 #include <deque>
 #include <epoxy/egl.h>
 #include <memory>
@@ -92,12 +94,88 @@ public:
         return true;
     }
 
+    /**
+     * Puts a client buffer directly onto the primary plane instead of a composited frame. Returns
+     * @c false when the output test fails, in which case the frame must be composited.
+     */
+    template<typename Dmabuf>
+    bool scanout(std::shared_ptr<Wrapland::Server::Buffer> const& buffer, Dmabuf const& dmabuf)
+    {
+        auto wlr_buf = wlr_client_dmabuf_buffer_create(buffer, dmabuf);
+        if (!wlr_buf) {
+            return false;
+        }
+
+        auto& base = static_cast<typename Output::base_t&>(out->base);
+        out->swap_pending = true;
+
+        auto const success = commit_scanout_buffer(base, &wlr_buf->base);
+
+        // Pending and committed output states hold their own locks on the buffer.
+        wlr_buffer_drop(&wlr_buf->base);
+
+        if (!success) {
+            out->swap_pending = false;
+            return false;
+        }
+
+        // The buffers of our swapchain did not get the content of this frame. So the next
+        // composited frame must not rely on the damage history and repaint completely.
+        damageHistory.clear();
+        return true;
+    }
+
     Output* out;
     int bufferAge{0};
     wayland::egl_data egl_data;
 
     /** Damage history for the past 10 frames. */
     std::deque<QRegion> damageHistory;
+
+private:
+    template<typename Base>
+    static bool commit_scanout_buffer(Base& base, wlr_buffer* buffer)
+    {
+#if WLR_HAVE_NEW_PIXEL_COPY_API
+        // Test on a copy so pending state changes are not lost when we have to fall back to
+        // composition.
+        typename decltype(base.next_state)::element_type state;
+        if (base.next_state) {
+            wlr_output_state_copy(state.get_native(), base.next_state->get_native());
+        } else {
+            wlr_output_state_set_enabled(state.get_native(), true);
+        }
+        wlr_output_state_set_buffer(state.get_native(), buffer);
+
+        if (!wlr_output_test_state(base.native, state.get_native())) {
+            qCDebug(KWIN_CORE) << "Output test failed on direct scanout.";
+            return false;
+        }
+        if (!wlr_output_commit_state(base.native, state.get_native())) {
+            qCWarning(KWIN_CORE) << "Output commit failed on direct scanout.";
+            return false;
+        }
+
+        base.next_state.reset();
+#else
+        if (!base.native->enabled) {
+            wlr_output_enable(base.native, true);
+        }
+
+        wlr_output_attach_buffer(base.native, buffer);
+
+        if (!wlr_output_test(base.native)) {
+            qCDebug(KWIN_CORE) << "Output test failed on direct scanout.";
+            wlr_output_rollback(base.native);
+            return false;
+        }
+        if (!wlr_output_commit(base.native)) {
+            qCWarning(KWIN_CORE) << "Output commit failed on direct scanout.";
+            return false;
+        }
+#endif
+        return true;
+    }
 };
 
 }
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "egl_output.h"
+#include "output_cursor.h"
 #include "output_event.h"
 #include "qpainter_output.h"
 #include "wlr_includes.h"
@@ -34,6 +35,7 @@ public:
 
     output(base_t& base, Backend& backend)
         : abstract_type(base, *backend.frontend)
+        , cursor{*this}
     {
         this->swap_pending = base.native->frame_pending;
 
@@ -51,14 +53,105 @@ public:
         frame_rec.receiver = this;
         frame_rec.event.notify = output_handle_frame<output>;
         wl_signal_add(&base.native->events.frame, &frame_rec.event);
+
+        needs_frame_rec.receiver = this;
+        needs_frame_rec.event.notify = output_handle_needs_frame<output>;
+        wl_signal_add(&base.native->events.needs_frame, &needs_frame_rec.event);
+    }
+
+    void frame()
+    {
+        if (cursor_commit_pending) {
+            cursor_commit_pending = false;
+            this->swap_pending = false;
+
+            // Repaints scheduled in the meantime were deferred to this event.
+            this->set_delay_timer();
+            return;
+        }
+
+        abstract_type::frame();
+    }
+
+    /**
+     * Called when the hardware cursor changed. The change is applied with the next commit. Unless
+     * a composited frame is about to be committed anyway, the cursor is committed alone without
+     * painting a frame.
+     */
+    void needs_frame()
+    {
+        // wlroots only signals again after the next commit, so the update must not get lost.
+        cursor_update_pending = true;
+        commit_cursor();
     }
 
     std::unique_ptr<egl_output_t> egl;
     std::unique_ptr<qpainter_output_t> qpainter;
+    output_cursor<type> cursor;
 
 private:
+    void timerEvent(QTimerEvent* event) override
+    {
+        auto const is_run = event->timerId() == this->delay_timer.timerId();
+        auto const was_swap_pending = this->swap_pending;
+
+        abstract_type::timerEvent(event);
+
+        if (!is_run || !cursor_update_pending) {
+            return;
+        }
+        if (!was_swap_pending && this->swap_pending) {
+            // A composited frame was committed and carried the cursor update.
+            cursor_update_pending = false;
+            return;
+        }
+
+        // The run had nothing to paint.
+        commit_cursor();
+    }
+
+    /// Commits a pending cursor update. If the output is busy it is retried after the next run.
+    void commit_cursor()
+    {
+        if (wayland::output_waiting_for_event(*this)) {
+            return;
+        }
+
+        auto& base = static_cast<base_t&>(this->base);
+
+#if WLR_HAVE_NEW_PIXEL_COPY_API
+        if (base.next_state) {
+            // Pending output changes go out with a composited frame.
+            this->add_repaint(base.geometry());
+            return;
+        }
+
+        typename decltype(base.next_state)::element_type state;
+        auto const success = wlr_output_commit_state(base.native, state.get_native());
+#else
+        auto const success = wlr_output_commit(base.native);
+#endif
+
+        cursor_update_pending = false;
+
+        if (!success) {
+            qCDebug(KWIN_CORE) << "Output commit failed on cursor update.";
+            return;
+        }
+
+        // Only DRM outputs are known to always send a frame event after an empty commit. Other
+        // backends apply the cursor without waiting for it.
+        if (wlr_output_is_drm(base.native)) {
+            this->swap_pending = true;
+            cursor_commit_pending = true;
+        }
+    }
+
     base::event_receiver<output> present_rec;
     base::event_receiver<output> frame_rec;
+    base::event_receiver<output> needs_frame_rec;
+    bool cursor_commit_pending{false};
+    bool cursor_update_pending{false};
 };
 
 }
@@ -0,0 +1,141 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "wlr_includes.h"
+#include "wlr_non_owning_data_buffer.h"
+
+#include <QImage>
+#include <QPoint>
+#include <drm_fourcc.h>
+
+namespace como::render::backend::wlroots
+{
+
+/**
+ * Cursor of an output in a hardware cursor plane. The image is scaled to the output scale here,
+ * the output transform is applied by wlroots.
+ */
+template<typename Output>
+class output_cursor
+{
+public:
+    explicit output_cursor(Output& out)
+        : out{out}
+    {
+    }
+
+    ~output_cursor()
+    {
+        reset();
+    }
+
+    output_cursor(output_cursor const&) = delete;
+    output_cursor& operator=(output_cursor const&) = delete;
+
+    /**
+     * Shows @p image with @p hotspot in logical coordinates. Returns false if the output has no
+     * cursor plane for the image. The cursor must then be painted in software.
+     */
+    bool set_image(QImage const& image, QPoint const& hotspot)
+    {
+        auto& base = get_base();
+        if (!native) {
+            native = wlr_output_cursor_create(base.native);
+            if (!native) {
+                return false;
+            }
+        }
+
+        auto const scale = base.scale();
+        auto const size = (image.deviceIndependentSize() * scale).toSize();
+
+        auto scaled = image.size() == size
+            ? image
+            : image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        scaled.convertTo(QImage::Format_ARGB32_Premultiplied);
+
+        auto buffer = wlr_non_owning_data_buffer_create(scaled.width(),
+                                                        scaled.height(),
+                                                        DRM_FORMAT_ARGB8888,
+                                                        scaled.bytesPerLine(),
+                                                        scaled.bits());
+        if (!buffer) {
+            hide();
+            return false;
+        }
+
+        auto const buffer_hotspot = hotspot * scale;
+        auto const success = wlr_output_cursor_set_buffer(
+            native, &buffer->base, buffer_hotspot.x(), buffer_hotspot.y());
+
+        // The cursor holds a lock on its buffer. The previous buffer is released now.
+        drop_buffer();
+        this->buffer = &buffer->base;
+        this->image = std::move(scaled);
+
+        if (!success || base.native->hardware_cursor != native) {
+            hide();
+            return false;
+        }
+        return true;
+    }
+
+    /// Moves the cursor to @p pos in global logical coordinates.
+    void move(QPoint const& pos)
+    {
+        if (!buffer) {
+            return;
+        }
+
+        auto const geo = get_base().geometry();
+        wlr_output_cursor_move(native, pos.x() - geo.x(), pos.y() - geo.y());
+    }
+
+    void hide()
+    {
+        if (!buffer) {
+            return;
+        }
+
+        wlr_output_cursor_set_buffer(native, nullptr, 0, 0);
+        drop_buffer();
+    }
+
+    /// Must be called before the native output is destroyed.
+    void reset()
+    {
+        if (native) {
+            wlr_output_cursor_destroy(native);
+            native = nullptr;
+        }
+        drop_buffer();
+    }
+
+private:
+    auto& get_base()
+    {
+        return static_cast<typename Output::base_t&>(out.base);
+    }
+
+    void drop_buffer()
+    {
+        if (buffer) {
+            wlr_buffer_drop(buffer);
+            buffer = nullptr;
+        }
+        image = {};
+    }
+
+    Output& out;
+    wlr_output_cursor* native{nullptr};
+
+    // The buffer references the data of the image.
+    wlr_buffer* buffer{nullptr};
+    QImage image;
+};
+
+}
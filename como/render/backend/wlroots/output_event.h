@@ -63,4 +63,14 @@ void output_handle_frame(wl_listener* listener, void* /*data*/)
     output->frame();
 }
 
+template<typename Output>
+void output_handle_needs_frame(wl_listener* listener, void* /*data*/)
+{
+    base::event_receiver<Output>* event_receiver_struct
+        = wl_container_of(listener, event_receiver_struct, event);
+    auto output = event_receiver_struct->receiver;
+
+    output->needs_frame();
+}
+
 }
@@ -0,0 +1,260 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/base/logging.h>
+#include <como/render/gl/interface/utils.h>
+
+#include <QRegion>
+#include <array>
+#include <cstring>
+#include <drm_fourcc.h>
+#include <epoxy/gl.h>
+#include <memory>
+#include <vector>
+
+namespace como::render::backend::wlroots
+{
+
+/**
+ * Uploads pixel data to textures through a ring of pixel buffer objects. The damaged parts of the
+ * data are copied into a buffer and the texture is updated from there, so the transfer to the GPU
+ * happens asynchronously. Buffers are persistently mapped if supported and only written to again
+ * after a fence signaled that the previous upload from them is done.
+ */
+class pbo_upload
+{
+public:
+    /// Smaller uploads are cheaper to do synchronously.
+    static constexpr size_t min_upload_size{64 * 1024};
+
+    /// Returns null if the context does not support pixel buffer objects or they are disabled.
+    static std::unique_ptr<pbo_upload> create()
+    {
+        if (qEnvironmentVariableIsSet("KWIN_GL_PBO_UPLOAD")
+            && qEnvironmentVariableIntValue("KWIN_GL_PBO_UPLOAD") == 0) {
+            return {};
+        }
+        if (!hasGLVersion(3, 0)) {
+            return {};
+        }
+
+        auto const persistent = hasGLExtension(QByteArrayLiteral("GL_EXT_buffer_storage"));
+        qCDebug(KWIN_CORE) << "Uploading shm buffers through pixel buffer objects, persistent:"
+                           << persistent;
+
+        return std::unique_ptr<pbo_upload>(new pbo_upload(persistent));
+    }
+
+    ~pbo_upload()
+    {
+        for (auto& slot : slots) {
+            release(slot);
+        }
+    }
+
+    /**
+     * Updates the @p damage of @p texture from @p data. Returns false if the upload must be done
+     * synchronously instead, for example because the format is not supported or all buffers are
+     * still in use.
+     */
+    bool upload(GLuint texture,
+                uint32_t format,
+                uint32_t stride,
+                QSize const& size,
+                QRegion const& damage,
+                int32_t scale,
+                void const* data)
+    {
+        auto const gl_format = get_gl_format(format);
+        if (!gl_format) {
+            return false;
+        }
+
+        rects.clear();
+        size_t total_size{0};
+
+        for (auto const& rect : damage) {
+            auto const scaled = QRect(rect.topLeft() * scale, rect.size() * scale)
+                                    .intersected(QRect(QPoint(), size));
+            if (scaled.isEmpty()) {
+                continue;
+            }
+            rects.push_back(scaled);
+            total_size += static_cast<size_t>(scaled.width()) * scaled.height() * bytes_per_pixel;
+        }
+
+        if (total_size < min_upload_size) {
+            return false;
+        }
+
+        auto slot = acquire_slot(total_size);
+        if (!slot) {
+            return false;
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->buffer);
+
+        auto map = slot->map;
+        if (!persistent) {
+            map = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER,
+                                   0,
+                                   total_size,
+                                   GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (!map) {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                return false;
+            }
+        }
+
+        // Rows of each rectangle are packed tightly one after the other.
+        auto dst = static_cast<uint8_t*>(map);
+        auto const src = static_cast<uint8_t const*>(data);
+
+        for (auto const& rect : rects) {
+            auto const row_size = static_cast<size_t>(rect.width()) * bytes_per_pixel;
+            for (int y = rect.top(); y <= rect.bottom(); y++) {
+                std::memcpy(dst,
+                            src + static_cast<size_t>(y) * stride
+                                + static_cast<size_t>(rect.x()) * bytes_per_pixel,
+                            row_size);
+                dst += row_size;
+            }
+        }
+
+        if (!persistent) {
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        }
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        size_t offset{0};
+        for (auto const& rect : rects) {
+            glTexSubImage2D(GL_TEXTURE_2D,
+                            0,
+                            rect.x(),
+                            rect.y(),
+                            rect.width(),
+                            rect.height(),
+                            gl_format,
+                            GL_UNSIGNED_BYTE,
+                            reinterpret_cast<void const*>(offset));
+            offset += static_cast<size_t>(rect.width()) * rect.height() * bytes_per_pixel;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        return true;
+    }
+
+private:
+    struct slot {
+        GLuint buffer{0};
+        size_t size{0};
+        void* map{nullptr};
+        GLsync fence{nullptr};
+    };
+
+    explicit pbo_upload(bool persistent)
+        : persistent{persistent}
+    {
+    }
+
+    static GLenum get_gl_format(uint32_t format)
+    {
+        switch (format) {
+        case DRM_FORMAT_ARGB8888:
+        case DRM_FORMAT_XRGB8888:
+            return GL_BGRA_EXT;
+        case DRM_FORMAT_ABGR8888:
+        case DRM_FORMAT_XBGR8888:
+            return GL_RGBA;
+        default:
+            return 0;
+        }
+    }
+
+    /// Returns the next slot the GPU is done reading from, with a buffer of at least @p size.
+    slot* acquire_slot(size_t size)
+    {
+        for (size_t i = 0; i < slots.size(); i++) {
+            auto& slot = slots[(next + i) % slots.size()];
+
+            if (slot.fence) {
+                if (glClientWaitSync(slot.fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+                    continue;
+                }
+                glDeleteSync(slot.fence);
+                slot.fence = nullptr;
+            }
+
+            if (slot.size < size && !allocate(slot, size)) {
+                return nullptr;
+            }
+
+            next = (next + i + 1) % slots.size();
+            return &slot;
+        }
+
+        return nullptr;
+    }
+
+    bool allocate(slot& slot, size_t size)
+    {
+        release(slot);
+
+        glGenBuffers(1, &slot.buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+
+        if (persistent) {
+            auto const flags
+                = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT_EXT | GL_MAP_COHERENT_BIT_EXT;
+            glBufferStorageEXT(GL_PIXEL_UNPACK_BUFFER, size, nullptr, flags);
+            slot.map = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags);
+        } else {
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (persistent && !slot.map) {
+            qCWarning(KWIN_CORE) << "Failed to map pixel buffer object persistently.";
+            release(slot);
+            return false;
+        }
+
+        slot.size = size;
+        return true;
+    }
+
+    void release(slot& slot)
+    {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+        }
+        if (slot.map) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        if (slot.buffer) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+        slot = {};
+    }
+
+    static constexpr size_t bytes_per_pixel{4};
+
+    bool persistent;
+    std::array<slot, 3> slots;
+    size_t next{0};
+    std::vector<QRect> rects;
+};
+
+}
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "platform.h"
+#include "wlr_client_dmabuf_buffer.h"
 #include "wlr_helpers.h"
 #include "wlr_includes.h"
 #include "wlr_non_owning_data_buffer.h"
@@ -189,21 +190,7 @@ bool update_texture_from_dmabuf(Texture& texture, Dmabuf* dmabuf)
     if (texture.m_size != dmabuf->size) {
         // First time update or size has changed.
         // TODO(romangg): Should we also recreate the texture on other param changes?
-        wlr_dmabuf_attributes dmabuf_attribs;
-        auto const& planes = dmabuf->planes;
-        dmabuf_attribs.width = dmabuf->size.width();
-        dmabuf_attribs.height = dmabuf->size.height();
-        dmabuf_attribs.format = dmabuf->format;
-        dmabuf_attribs.modifier = dmabuf->modifier;
-        dmabuf_attribs.n_planes = planes.size();
-
-        auto planes_count = std::min(planes.size(), static_cast<size_t>(WLR_DMABUF_MAX_PLANES));
-        for (size_t i = 0; i < planes_count; i++) {
-            auto plane = planes.at(i);
-            dmabuf_attribs.offset[i] = plane.offset;
-            dmabuf_attribs.stride[i] = plane.stride;
-            dmabuf_attribs.fd[i] = plane.fd;
-        }
+        auto dmabuf_attribs = get_dmabuf_attributes(*dmabuf);
 
         wlr_texture_destroy(texture.native);
         texture.native
@@ -267,6 +254,11 @@ bool update_texture_from_data(Texture& texture,
 
     assert(size == texture.m_size);
 
+    if (auto& pbo = texture.m_backend->pbo;
+        pbo && pbo->upload(texture.m_texture, format, stride, size, damage, scale, data)) {
+        return true;
+    }
+
     auto buffer
         = wlr_non_owning_data_buffer_create(size.width(), size.height(), format, stride, data);
     auto pixman_damage = create_scaled_pixman_region(damage, scale);
@@ -0,0 +1,93 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "wlr_includes.h"
+
+#include <Wrapland/Server/buffer.h>
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+namespace como::render::backend::wlroots
+{
+
+template<typename Dmabuf>
+wlr_dmabuf_attributes get_dmabuf_attributes(Dmabuf const& dmabuf)
+{
+    wlr_dmabuf_attributes attribs{};
+    auto const& planes = dmabuf.planes;
+
+    attribs.width = dmabuf.size.width();
+    attribs.height = dmabuf.size.height();
+    attribs.format = dmabuf.format;
+    attribs.modifier = dmabuf.modifier;
+    attribs.n_planes = planes.size();
+
+    auto planes_count = std::min(planes.size(), static_cast<size_t>(WLR_DMABUF_MAX_PLANES));
+    for (size_t i = 0; i < planes_count; i++) {
+        auto plane = planes.at(i);
+        attribs.offset[i] = plane.offset;
+        attribs.stride[i] = plane.stride;
+        attribs.fd[i] = plane.fd;
+    }
+
+    return attribs;
+}
+
+/**
+ * Exposes the dmabuf of a client buffer as wlr_buffer, for example for direct scanout. The file
+ * descriptors stay owned by the client buffer, which is kept alive until wlroots releases the
+ * wlr_buffer.
+ */
+struct wlr_client_dmabuf_buffer {
+    wlr_buffer base;
+    wlr_dmabuf_attributes attribs;
+    std::shared_ptr<Wrapland::Server::Buffer>* client_buffer;
+};
+
+static void wlr_client_dmabuf_buffer_destroy(wlr_buffer* wlr_buf)
+{
+    wlr_client_dmabuf_buffer* buffer = wl_container_of(wlr_buf, buffer, base);
+    delete buffer->client_buffer;
+    free(buffer);
+}
+
+static bool wlr_client_dmabuf_buffer_get_dmabuf(wlr_buffer* wlr_buf,
+                                                wlr_dmabuf_attributes* attribs)
+{
+    wlr_client_dmabuf_buffer* buffer = wl_container_of(wlr_buf, buffer, base);
+    *attribs = buffer->attribs;
+    return true;
+}
+
+static wlr_buffer_impl const wlr_client_dmabuf_buffer_impl = {
+    .destroy = wlr_client_dmabuf_buffer_destroy,
+    .get_dmabuf = wlr_client_dmabuf_buffer_get_dmabuf,
+};
+
+template<typename Dmabuf>
+wlr_client_dmabuf_buffer*
+wlr_client_dmabuf_buffer_create(std::shared_ptr<Wrapland::Server::Buffer> const& client_buffer,
+                                Dmabuf const& dmabuf)
+{
+    assert(client_buffer);
+
+    auto buffer
+        = static_cast<wlr_client_dmabuf_buffer*>(calloc(1, sizeof(wlr_client_dmabuf_buffer)));
+    if (!buffer) {
+        return nullptr;
+    }
+
+    wlr_buffer_init(
+        &buffer->base, &wlr_client_dmabuf_buffer_impl, dmabuf.size.width(), dmabuf.size.height());
+    buffer->attribs = get_dmabuf_attributes(dmabuf);
+    buffer->client_buffer = new std::shared_ptr<Wrapland::Server::Buffer>(client_buffer);
+
+    return buffer;
+}
+
+}
@@ -31,6 +31,7 @@ extern "C" {
 #include <wlr/render/pixman.h>
 #include <wlr/render/wlr_texture.h>
 #include <wlr/types/wlr_buffer.h>
+#include <wlr/types/wlr_output.h>
 #include <wlr/util/log.h>
 #include <wlr/util/region.h>
 #if WLR_HAVE_UTIL_TRANSFORM_HEADER
@@ -53,10 +53,15 @@ public:
                 cursor, &cursor_t::pos_changed, qobject.get(), [this] { rerender(); });
             notifiers.image = QObject::connect(
                 cursor, &cursor_t::image_changed, qobject.get(), &cursor_qobject::changed);
+            Q_EMIT qobject->changed();
         } else {
             cursor->stop_image_tracking();
             QObject::disconnect(notifiers.pos);
             QObject::disconnect(notifiers.image);
+
+            // Remove the last painted cursor.
+            platform.addRepaint(last_rendered_geometry);
+            last_rendered_geometry = {};
         }
     }
 
@@ -0,0 +1,36 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "frame_telemetry.h"
+
+#include "frametelemetryadaptor.h"
+
+#include <QDBusConnection>
+
+namespace como::render::dbus
+{
+
+frame_telemetry_qobject::frame_telemetry_qobject()
+{
+    new FrameTelemetryAdaptor(this);
+    QDBusConnection::sessionBus().registerObject(QStringLiteral("/FrameTelemetry"), this);
+}
+
+QStringList frame_telemetry_qobject::outputs() const
+{
+    return integration.outputs();
+}
+
+QVariantMap frame_telemetry_qobject::statistics(QString const& output) const
+{
+    return integration.statistics(output);
+}
+
+void frame_telemetry_qobject::reset(QString const& output)
+{
+    integration.reset(output);
+}
+
+}
@@ -0,0 +1,124 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "como_export.h"
+
+#include <QObject>
+#include <QStringList>
+#include <QVariantMap>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace como::render::dbus
+{
+
+struct frame_telemetry_integration {
+    std::function<QStringList(void)> outputs;
+    std::function<QVariantMap(QString const&)> statistics;
+    std::function<void(QString const&)> reset;
+};
+
+class COMO_EXPORT frame_telemetry_qobject : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.kwin.FrameTelemetry")
+
+public:
+    frame_telemetry_qobject();
+    ~frame_telemetry_qobject() = default;
+
+    frame_telemetry_integration integration;
+
+public Q_SLOTS:
+    /// Names of the outputs telemetry is collected for.
+    QStringList outputs() const;
+
+    /**
+     * Frame timings of @p output. Durations are in microseconds. For each of paint, gpu,
+     * scheduleDelay and presentationLatency a map with count, last, max, p50, p95 and p99 is
+     * provided. Returns an empty map for an unknown output.
+     */
+    QVariantMap statistics(QString const& output) const;
+
+    /// Starts collecting anew on @p output or on all outputs if @p output is empty.
+    void reset(QString const& output);
+};
+
+template<typename Telemetry>
+QVariantMap get_duration_telemetry_map(Telemetry const& telemetry)
+{
+    auto to_us = [](std::chrono::nanoseconds duration) {
+        return static_cast<qint64>(
+            std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    };
+
+    return {
+        {QStringLiteral("count"), static_cast<qulonglong>(telemetry.count)},
+        {QStringLiteral("last"), to_us(telemetry.last)},
+        {QStringLiteral("max"), to_us(telemetry.max)},
+        {QStringLiteral("p50"), to_us(telemetry.histogram.get_percentile(0.5))},
+        {QStringLiteral("p95"), to_us(telemetry.histogram.get_percentile(0.95))},
+        {QStringLiteral("p99"), to_us(telemetry.histogram.get_percentile(0.99))},
+    };
+}
+
+template<typename Telemetry>
+QVariantMap get_output_telemetry_map(Telemetry const& telemetry)
+{
+    return {
+        {QStringLiteral("presentedFrames"), static_cast<qulonglong>(telemetry.presented_frames)},
+        {QStringLiteral("missedVblanks"), static_cast<qulonglong>(telemetry.missed_vblanks)},
+        {QStringLiteral("prepare"), get_duration_telemetry_map(telemetry.prepare)},
+        {QStringLiteral("paint"), get_duration_telemetry_map(telemetry.paint)},
+        {QStringLiteral("gpu"), get_duration_telemetry_map(telemetry.gpu)},
+        {QStringLiteral("scheduleDelay"), get_duration_telemetry_map(telemetry.schedule_delay)},
+        {QStringLiteral("presentationLatency"),
+         get_duration_telemetry_map(telemetry.presentation_latency)},
+    };
+}
+
+/// Exposes the frame timings the render outputs of @p Platform collect.
+template<typename Platform>
+class frame_telemetry
+{
+public:
+    explicit frame_telemetry(Platform& platform)
+        : qobject{std::make_unique<frame_telemetry_qobject>()}
+        , platform{platform}
+    {
+        qobject->integration.outputs = [this] {
+            QStringList names;
+            for (auto output : this->platform.base.outputs) {
+                names.append(output->name());
+            }
+            return names;
+        };
+        qobject->integration.statistics = [this](auto const& name) {
+            for (auto output : this->platform.base.outputs) {
+                if (output->name() == name && output->render) {
+                    return get_output_telemetry_map(output->render->telemetry);
+                }
+            }
+            return QVariantMap();
+        };
+        qobject->integration.reset = [this](auto const& name) {
+            for (auto output : this->platform.base.outputs) {
+                if ((name.isEmpty() || output->name() == name) && output->render) {
+                    output->render->telemetry.reset();
+                }
+            }
+        };
+    }
+
+    std::unique_ptr<frame_telemetry_qobject> qobject;
+
+private:
+    Platform& platform;
+};
+
+}
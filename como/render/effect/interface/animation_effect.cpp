@@ -80,6 +80,11 @@ bool AnimationEffect::isActive() const
     return !d_ptr->m_animations.isEmpty() && !effects->isScreenLocked();
 }
 
+bool AnimationEffect::isActiveFor(EffectWindow const* window) const
+{
+    return d_ptr->m_animations.contains(const_cast<EffectWindow*>(window));
+}
+
 #define RELATIVE_XY(_FIELD_)                                                                       \
     const bool relative[2] = {static_cast<bool>(metaData(Relative##_FIELD_##X, meta)),             \
                               static_cast<bool>(metaData(Relative##_FIELD_##Y, meta))}
@@ -298,6 +298,7 @@ public:
     ~AnimationEffect() override;
 
     bool isActive() const override;
+    bool isActiveFor(EffectWindow const* window) const override;
 
     /**
      * Gets stored metadata.
@@ -80,6 +80,11 @@ bool Effect::isActive() const
     return true;
 }
 
+bool Effect::isActiveFor(EffectWindow const* /*window*/) const
+{
+    return true;
+}
+
 QString Effect::debug(const QString&) const
 {
     return QString();
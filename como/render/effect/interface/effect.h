@@ -308,6 +308,20 @@ public:
      */
     virtual bool isActive() const;
 
+    /**
+     * Overwrite this method to restrict the windows an active effect is interested in. If the
+     * method returns @c false for a window, the effect is excluded from the chained prePaintWindow,
+     * paintWindow, postPaintWindow and drawWindow calls for this window in the next rendered frame.
+     *
+     * The method is only called when isActive returned @c true. The compositor also calls it to
+     * decide whether a window can be skipped or presented without composition, so it may be
+     * called several times per window and frame. Like isActive it should not perform complex
+     * calculations.
+     *
+     * The default implementation of this method returns @c true.
+     */
+    virtual bool isActiveFor(EffectWindow const* window) const;
+
     /**
      * Reimplement this method to provide online debugging.
      * This could be as trivial as printing specific detail information about the effect state
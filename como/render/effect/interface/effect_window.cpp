@@ -33,6 +33,12 @@ EffectWindow::~EffectWindow()
 {
 }
 
+size_t EffectWindow::registerDataSlot()
+{
+    static size_t count{0};
+    return count++;
+}
+
 bool EffectWindow::isOnActivity(const QString& activity) const
 {
     const QStringList _activities = activities();
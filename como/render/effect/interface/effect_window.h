@@ -14,6 +14,12 @@
 #include <QObject>
 #include <QWindow>
 
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+
 namespace KDecoration2
 {
 class Decoration;
@@ -30,6 +36,28 @@ namespace como
 class EffectWindowVisibleRef;
 class WindowQuadList;
 
+/**
+ * Typed key for per-window data of an effect. In contrast to data roles a slot is not shared
+ * with other effects or scripts. The value is stored unboxed in the window and looked up by index.
+ *
+ * A slot should be created once per effect, for example as a member of the effect. Values must
+ * be small and trivially copyable, typically a pointer into state owned by the effect.
+ */
+template<typename T>
+class EffectWindowDataSlot
+{
+public:
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(sizeof(T) <= 16 && alignof(T) <= alignof(std::max_align_t));
+
+    EffectWindowDataSlot();
+
+    EffectWindowDataSlot(EffectWindowDataSlot const&) = delete;
+    EffectWindowDataSlot& operator=(EffectWindowDataSlot const&) = delete;
+
+    size_t const index;
+};
+
 class EffectWindowGroup
 {
 public:
@@ -677,6 +705,44 @@ public:
     Q_SCRIPTABLE virtual void setData(int role, const QVariant& data) = 0;
     Q_SCRIPTABLE virtual QVariant data(int role) const = 0;
 
+    /**
+     * Typed alternative to data roles for effect-private data. Does not emit
+     * EffectsHandler::windowDataChanged.
+     *
+     * @return pointer to the value in @p slot or nullptr if it is not set.
+     */
+    template<typename T>
+    T const* slotData(EffectWindowDataSlot<T> const& slot) const
+    {
+        if (slot.index >= m_slots.size() || !m_slots[slot.index].is_set) {
+            return nullptr;
+        }
+        return std::launder(reinterpret_cast<T const*>(m_slots[slot.index].value));
+    }
+
+    template<typename T>
+    void setSlotData(EffectWindowDataSlot<T> const& slot, T const& value)
+    {
+        if (slot.index >= m_slots.size()) {
+            m_slots.resize(slot.index + 1);
+        }
+
+        auto& entry = m_slots[slot.index];
+        std::memcpy(entry.value, &value, sizeof(T));
+        entry.is_set = true;
+    }
+
+    template<typename T>
+    void resetSlotData(EffectWindowDataSlot<T> const& slot)
+    {
+        if (slot.index < m_slots.size()) {
+            m_slots[slot.index].is_set = false;
+        }
+    }
+
+    /// Returns a new index for an EffectWindowDataSlot. Indices are never reused.
+    static size_t registerDataSlot();
+
     /**
      * @brief References the previous window pixmap to prevent discarding.
      *
@@ -867,10 +933,22 @@ protected:
     virtual void unrefVisible(EffectWindowVisibleRef const* holder) = 0;
 
 private:
+    struct data_slot {
+        alignas(std::max_align_t) std::byte value[16];
+        bool is_set{false};
+    };
+
     class Private;
     QScopedPointer<Private> d;
+    std::vector<data_slot> m_slots;
 };
 
+template<typename T>
+EffectWindowDataSlot<T>::EffectWindowDataSlot()
+    : index{EffectWindow::registerDataSlot()}
+{
+}
+
 }
 
 Q_DECLARE_METATYPE(como::EffectWindow*)
@@ -56,7 +56,7 @@ enum DataRole {
     WindowForceBlurRole,               ///< For fullscreen effects to enforce blurring of windows,
     WindowForceBackgroundContrastRole, ///< For fullscreen effects to enforce the background
                                        ///< contrast,
-    LanczosCacheRole
+    LanczosCacheRole ///< Unused, the scene keeps scaled textures in its own cache.
 };
 
 /**
@@ -23,6 +23,7 @@
 #include <como/render/effect/interface/effects_handler.h>
 #include <como/render/effect/interface/window_quad.h>
 #include <como/render/gl/interface/texture.h>
+#include <como/render/gl/lanczos_cache.h>
 
 #include <QHash>
 
@@ -61,11 +62,7 @@ public:
 
     ~effects_window_impl() override
     {
-        QVariant cachedTextureVariant = data(LanczosCacheRole);
-        if (cachedTextureVariant.isValid()) {
-            auto cachedTexture = static_cast<GLTexture*>(cachedTextureVariant.value<void*>());
-            delete cachedTexture;
-        }
+        gl::lanczos_cache::release(*this);
     }
 
     void addRepaint(QRect const& rect) override
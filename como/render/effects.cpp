@@ -80,7 +80,12 @@ void effects_handler_wrap::postPaintScreen()
 
 void effects_handler_wrap::prePaintWindow(effect::window_prepaint_data& data)
 {
-    if (m_currentPaintWindowIterator != m_activeEffects.constEnd()) {
+    if (m_currentPaintWindowIterator == m_paintWindowEffects->constBegin()) {
+        // Entering the chain. Only call the effects that are interested in this window.
+        m_paintWindowEffects = &get_window_effects(&data.window);
+        m_currentPaintWindowIterator = m_paintWindowEffects->constBegin();
+    }
+    if (m_currentPaintWindowIterator != m_paintWindowEffects->constEnd()) {
         (*m_currentPaintWindowIterator++)->prePaintWindow(data);
         --m_currentPaintWindowIterator;
     }
@@ -89,7 +94,11 @@ void effects_handler_wrap::prePaintWindow(effect::window_prepaint_data& data)
 
 void effects_handler_wrap::paintWindow(effect::window_paint_data& data)
 {
-    if (m_currentPaintWindowIterator != m_activeEffects.constEnd()) {
+    if (m_currentPaintWindowIterator == m_paintWindowEffects->constBegin()) {
+        m_paintWindowEffects = &get_window_effects(&data.window);
+        m_currentPaintWindowIterator = m_paintWindowEffects->constBegin();
+    }
+    if (m_currentPaintWindowIterator != m_paintWindowEffects->constEnd()) {
         (*m_currentPaintWindowIterator++)->paintWindow(data);
         --m_currentPaintWindowIterator;
     } else {
@@ -99,7 +108,11 @@ void effects_handler_wrap::paintWindow(effect::window_paint_data& data)
 
 void effects_handler_wrap::postPaintWindow(EffectWindow* w)
 {
-    if (m_currentPaintWindowIterator != m_activeEffects.constEnd()) {
+    if (m_currentPaintWindowIterator == m_paintWindowEffects->constBegin()) {
+        m_paintWindowEffects = &get_window_effects(w);
+        m_currentPaintWindowIterator = m_paintWindowEffects->constBegin();
+    }
+    if (m_currentPaintWindowIterator != m_paintWindowEffects->constEnd()) {
         (*m_currentPaintWindowIterator++)->postPaintWindow(w);
         --m_currentPaintWindowIterator;
     }
@@ -116,7 +129,11 @@ Effect* effects_handler_wrap::provides(Effect::Feature ef)
 
 void effects_handler_wrap::drawWindow(effect::window_paint_data& data)
 {
-    if (m_currentDrawWindowIterator != m_activeEffects.constEnd()) {
+    if (m_currentDrawWindowIterator == m_drawWindowEffects->constBegin()) {
+        m_drawWindowEffects = &get_window_effects(&data.window);
+        m_currentDrawWindowIterator = m_drawWindowEffects->constBegin();
+    }
+    if (m_currentDrawWindowIterator != m_drawWindowEffects->constEnd()) {
         (*m_currentDrawWindowIterator++)->drawWindow(data);
         --m_currentDrawWindowIterator;
     } else {
@@ -159,9 +176,63 @@ void effects_handler_wrap::startPaint()
             m_activeEffects << it->second;
         }
     }
+    reset_window_effects();
+    m_currentPaintScreenIterator = m_activeEffects.constBegin();
+}
+
+void effects_handler_wrap::reset_window_effects()
+{
+    m_windowEffects.clear();
+    m_paintWindowEffects = &m_activeEffects;
+    m_drawWindowEffects = &m_activeEffects;
     m_currentDrawWindowIterator = m_activeEffects.constBegin();
     m_currentPaintWindowIterator = m_activeEffects.constBegin();
-    m_currentPaintScreenIterator = m_activeEffects.constBegin();
+}
+
+effects_handler_wrap::EffectsList const&
+effects_handler_wrap::get_window_effects(EffectWindow const* window)
+{
+    auto [it, inserted] = m_windowEffects.try_emplace(window);
+    auto& chain = it->second;
+    if (!inserted) {
+        return chain;
+    }
+
+    auto is_inactive = [window](auto effect) { return !effect->isActiveFor(window); };
+    auto const first_inactive
+        = std::find_if(m_activeEffects.constBegin(), m_activeEffects.constEnd(), is_inactive);
+
+    if (first_inactive == m_activeEffects.constEnd()) {
+        // Shares the data with the list of active effects.
+        chain = m_activeEffects;
+        return chain;
+    }
+
+    chain.reserve(m_activeEffects.size() - 1);
+    std::copy(m_activeEffects.constBegin(), first_inactive, std::back_inserter(chain));
+    std::copy_if(std::next(first_inactive),
+                 m_activeEffects.constEnd(),
+                 std::back_inserter(chain),
+                 [window](auto effect) { return effect->isActiveFor(window); });
+    return chain;
+}
+
+bool effects_handler_wrap::affects_window(EffectWindow const* window) const
+{
+    if (fullscreen_effect) {
+        return true;
+    }
+
+    return std::any_of(loaded_effects.cbegin(), loaded_effects.cend(), [window](auto const& entry) {
+        auto effect = entry.second;
+
+        // Blur and contrast only paint behind the window.
+        if (effect->provides(Effect::Blur) || effect->provides(Effect::Contrast)) {
+            return false;
+        }
+
+        return effect->isActive() && effect->isActiveFor(window);
+    });
 }
 
 void effects_handler_wrap::setActiveFullScreenEffect(Effect* e)
@@ -476,6 +547,7 @@ void effects_handler_wrap::effectsChanged()
     loaded_effects.clear();
     m_activeEffects.clear(); // it's possible to have a reconfigure and a quad rebuild between two
                              // paint cycles - bug #308201
+    reset_window_effects();
 
     loaded_effects.reserve(effect_order.count());
     std::copy(
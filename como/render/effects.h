@@ -34,6 +34,7 @@
 #include <QMouseEvent>
 #include <memory>
 #include <set>
+#include <unordered_map>
 
 namespace Wrapland::Server
 {
@@ -77,6 +78,7 @@ public:
         // init is important, otherwise causes crashes when quads are build before the first
         // painting pass start
         m_currentBuildQuadsIterator = m_activeEffects.constEnd();
+        reset_window_effects();
     }
 
     ~effects_handler_wrap() override;
@@ -136,6 +138,8 @@ public:
 
     // internal (used by kwin core or compositing code)
     void startPaint();
+    /// Whether an active effect might change how @p window is painted or where.
+    bool affects_window(EffectWindow const* window) const;
     void grabbedKeyboardEvent(QKeyEvent* e);
     bool hasKeyboardGrab() const;
 
@@ -236,7 +240,15 @@ private:
     typedef QVector<Effect*> EffectsList;
     typedef EffectsList::const_iterator EffectsIterator;
 
+    void reset_window_effects();
+
+    /// Active effects interested in @p window. Cached until the next painting pass.
+    EffectsList const& get_window_effects(EffectWindow const* window);
+
     EffectsList m_activeEffects;
+    std::unordered_map<EffectWindow const*, EffectsList> m_windowEffects;
+    EffectsList const* m_paintWindowEffects{&m_activeEffects};
+    EffectsList const* m_drawWindowEffects{&m_activeEffects};
     EffectsIterator m_currentDrawWindowIterator;
     EffectsIterator m_currentPaintWindowIterator;
     EffectsIterator m_currentPaintScreenIterator;
@@ -89,6 +89,16 @@ public:
 
     virtual QRegion get_output_render_region(base::output const& /*output*/) const = 0;
 
+    /**
+     * Tries to present the buffer of @p window directly on the output without composition.
+     *
+     * @return @c true if the buffer has been submitted, @c false if the frame must be composited.
+     */
+    virtual bool direct_scanout(base::output* /*output*/, typename Scene::window_t& /*window*/)
+    {
+        return false;
+    }
+
     virtual void try_present()
     {
         assert(false);
@@ -14,7 +14,10 @@
 
 #include <como/render/gl/interface/utils.h>
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <vector>
 
 namespace como::render::gl
 {
@@ -44,6 +47,51 @@ inline QImage rotate_and_flip(const QImage& srcImage, const QRect& srcRect)
     return image;
 }
 
+/**
+ * Decoration textures currently not used by any window. Windows with the same decoration size
+ * and windows that are resized back to an earlier size take their texture from here instead of
+ * allocating a new one. The most recently returned textures are kept.
+ */
+class deco_texture_pool
+{
+public:
+    std::unique_ptr<GLTexture> take(QSize const& size)
+    {
+        auto it = std::find_if(textures.rbegin(), textures.rend(), [&](auto const& texture) {
+            return texture->size() == size;
+        });
+        if (it == textures.rend()) {
+            return {};
+        }
+
+        auto texture = std::move(*it);
+        textures.erase(std::next(it).base());
+        return texture;
+    }
+
+    void give(std::unique_ptr<GLTexture> texture)
+    {
+        if (!texture) {
+            return;
+        }
+        if (textures.size() == max_size) {
+            textures.erase(textures.begin());
+        }
+        textures.push_back(std::move(texture));
+    }
+
+    /// Must be called with the context current.
+    void clear()
+    {
+        textures.clear();
+    }
+
+    size_t max_size{8};
+
+private:
+    std::vector<std::unique_ptr<GLTexture>> textures;
+};
+
 template<typename Scene>
 class deco_render_data : public win::deco::render_data
 {
@@ -56,6 +104,7 @@ public:
     ~deco_render_data() override
     {
         scene.makeOpenGLContextCurrent();
+        scene.deco_textures.give(std::move(texture));
     }
 
     std::unique_ptr<GLTexture> texture;
@@ -95,8 +144,14 @@ public:
         QRect left, top, right, bottom;
         this->window.layout_rects(left, top, right, bottom);
 
-        auto const geometry
-            = dirty ? QRect({}, this->window.geo().size()) : scheduled.boundingRect();
+        // Only repaint the damaged rectangles, for example a single button on hover. When the
+        // damage is fragmented a repaint of its bounding rectangle is cheaper than many uploads.
+        auto damage = scheduled;
+        if (dirty) {
+            damage = QRect({}, this->window.geo().size());
+        } else if (damage.rectCount() > 4) {
+            damage = damage.boundingRect();
+        }
 
         // We pad each part in the decoration atlas in order to avoid texture bleeding.
         const int padding = 1;
@@ -166,10 +221,12 @@ public:
         const QPoint leftPosition(padding, bottomPosition.y() + bottom.height() + 2 * padding);
         const QPoint rightPosition(padding, leftPosition.y() + left.width() + 2 * padding);
 
-        renderPart(left.intersected(geometry), left, leftPosition, true);
-        renderPart(top.intersected(geometry), top, topPosition);
-        renderPart(right.intersected(geometry), right, rightPosition, true);
-        renderPart(bottom.intersected(geometry), bottom, bottomPosition);
+        for (auto const& rect : damage) {
+            renderPart(left.intersected(rect), left, leftPosition, true);
+            renderPart(top.intersected(rect), top, topPosition);
+            renderPart(right.intersected(rect), right, rightPosition, true);
+            renderPart(bottom.intersected(rect), bottom, bottomPosition);
+        }
     }
 
     GLTexture* texture()
@@ -260,8 +317,16 @@ private:
             return;
         }
 
+        scene.deco_textures.give(std::move(data.texture));
+
         if (size.isEmpty()) {
-            data.texture.reset();
+            return;
+        }
+
+        // A texture from the pool keeps its settings. Its old content is overwritten since the
+        // first render after a resize repaints all parts.
+        data.texture = scene.deco_textures.take(size);
+        if (data.texture) {
             return;
         }
 
@@ -0,0 +1,210 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "program_cache.h"
+
+#include "platform.h"
+#include "utils.h"
+
+#include <como/base/logging.h>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace como
+{
+
+static bool program_binaries_supported()
+{
+    if (GLPlatform::instance()->isGLES()) {
+        return hasGLVersion(3, 0);
+    }
+    return hasGLVersion(4, 1) || hasGLExtension(QByteArrayLiteral("GL_ARB_get_program_binary"));
+}
+
+GLProgramCache::GLProgramCache()
+{
+    if (qEnvironmentVariableIsSet("KWIN_GL_PROGRAM_CACHE")
+        && qEnvironmentVariableIntValue("KWIN_GL_PROGRAM_CACHE") == 0) {
+        qCDebug(KWIN_CORE) << "Shader program cache disabled by environment variable.";
+        return;
+    }
+
+    if (!program_binaries_supported()) {
+        return;
+    }
+
+    GLint formats{0};
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) {
+        return;
+    }
+
+    auto const platform = GLPlatform::instance();
+    m_driver = platform->glVendorString() + '\n' + platform->glRendererString() + '\n'
+        + platform->glVersionString() + '\n' + platform->glShadingLanguageVersionString() + '\n';
+
+    // Binaries are kept in a directory per driver. Other drivers may still be in use, for example
+    // by another GPU or a nested session, so their directories are only removed when they were
+    // not used for a while.
+    auto const driverKey = QString::fromLatin1(
+        QCryptographicHash::hash(m_driver, QCryptographicHash::Sha1).toHex());
+    auto const root = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+        + QStringLiteral("/como/shaders");
+
+    m_directory = root + QLatin1Char('/') + driverKey;
+    if (!QDir().mkpath(m_directory)) {
+        qCWarning(KWIN_CORE) << "Failed to create shader program cache directory" << m_directory;
+        return;
+    }
+
+    markUsed(m_directory);
+    removeStaleEntries(root, driverKey);
+
+    m_enabled = true;
+}
+
+static QString usedStampPath(QString const& directory)
+{
+    return directory + QStringLiteral("/last-used");
+}
+
+void GLProgramCache::markUsed(QString const& directory)
+{
+    QFile stamp(usedStampPath(directory));
+    if (!stamp.open(QIODevice::ReadWrite)
+        || !stamp.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime)) {
+        qCDebug(KWIN_CORE) << "Failed to mark shader program cache as used" << directory;
+    }
+}
+
+void GLProgramCache::removeStaleEntries(QString const& root, QString const& driverKey)
+{
+    // Including the directory of the current driver.
+    constexpr size_t maxDrivers{4};
+    constexpr int maxUnusedDays{30};
+
+    QDir dir(root);
+    auto const entries = dir.entryInfoList(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+
+    std::vector<std::pair<QDateTime, QFileInfo>> others;
+    for (auto const& entry : entries) {
+        if (entry.fileName() == driverKey) {
+            continue;
+        }
+
+        auto lastUsed = entry.lastModified();
+        if (entry.isDir()) {
+            if (QFileInfo const stamp(usedStampPath(entry.filePath())); stamp.exists()) {
+                lastUsed = stamp.lastModified();
+            }
+        }
+        others.emplace_back(lastUsed, entry);
+    }
+
+    // Most recently used first.
+    std::sort(others.begin(), others.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.first > rhs.first;
+    });
+
+    auto const expiry = QDateTime::currentDateTime().addDays(-maxUnusedDays);
+
+    for (size_t index = 0; index < others.size(); index++) {
+        auto const& [lastUsed, entry] = others.at(index);
+        if (index + 1 < maxDrivers && lastUsed >= expiry) {
+            continue;
+        }
+
+        auto const removed = entry.isDir() ? QDir(entry.filePath()).removeRecursively()
+                                           : QFile::remove(entry.filePath());
+        if (!removed) {
+            qCWarning(KWIN_CORE) << "Failed to remove stale shader program cache entry"
+                                 << entry.filePath();
+        }
+    }
+}
+
+QByteArray GLProgramCache::key(QByteArray const& vertexSource,
+                               QByteArray const& fragmentSource) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(m_driver);
+    hash.addData(QByteArray::number(vertexSource.size()) + '\n');
+    hash.addData(vertexSource);
+    hash.addData(QByteArray::number(fragmentSource.size()) + '\n');
+    hash.addData(fragmentSource);
+    return hash.result().toHex();
+}
+
+QString GLProgramCache::filePath(QByteArray const& key) const
+{
+    return m_directory + QLatin1Char('/') + QString::fromLatin1(key);
+}
+
+bool GLProgramCache::load(GLuint program, QByteArray const& key) const
+{
+    QFile file(filePath(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    auto const data = file.readAll();
+    if (data.size() <= static_cast<qsizetype>(sizeof(GLenum))) {
+        file.remove();
+        return false;
+    }
+
+    GLenum format;
+    std::memcpy(&format, data.constData(), sizeof(format));
+    glProgramBinary(program, format, data.constData() + sizeof(format), data.size() - sizeof(format));
+
+    GLint status{0};
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+
+    if (!status) {
+        // The driver rejected the binary, for example because it was built with another version.
+        qCDebug(KWIN_CORE) << "Discarding incompatible shader program binary" << key;
+        file.remove();
+        return false;
+    }
+
+    return true;
+}
+
+void GLProgramCache::store(GLuint program, QByteArray const& key) const
+{
+    GLint length{0};
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    QByteArray data(sizeof(GLenum) + length, Qt::Uninitialized);
+    GLenum format{0};
+    GLsizei written{0};
+    glGetProgramBinary(program, length, &written, &format, data.data() + sizeof(GLenum));
+    if (written <= 0) {
+        return;
+    }
+
+    std::memcpy(data.data(), &format, sizeof(format));
+    data.truncate(sizeof(GLenum) + written);
+
+    QSaveFile file(filePath(key));
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(KWIN_CORE) << "Failed to store shader program binary" << file.fileName();
+    }
+}
+
+}
@@ -0,0 +1,54 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <epoxy/gl.h>
+
+namespace como
+{
+
+/**
+ * On-disk cache of linked shader programs. Programs are identified by their sources and the
+ * driver, so a driver update invalidates all entries. Entries of other drivers are removed when
+ * they were not used for 30 days or when there are entries of more than four drivers.
+ *
+ * The cache requires OpenGL 4.1, GL_ARB_get_program_binary or OpenGL ES 3.0 and can be disabled
+ * by setting the environment variable KWIN_GL_PROGRAM_CACHE to 0.
+ */
+class GLProgramCache
+{
+public:
+    GLProgramCache();
+
+    bool isEnabled() const
+    {
+        return m_enabled;
+    }
+
+    QByteArray key(QByteArray const& vertexSource, QByteArray const& fragmentSource) const;
+
+    /**
+     * Loads the binary stored under @p key into @p program.
+     * @returns whether @p program is linked afterwards.
+     */
+    bool load(GLuint program, QByteArray const& key) const;
+
+    /// Stores the binary of the linked @p program under @p key.
+    void store(GLuint program, QByteArray const& key) const;
+
+private:
+    QString filePath(QByteArray const& key) const;
+    static void markUsed(QString const& directory);
+    static void removeStaleEntries(QString const& root, QString const& driverKey);
+
+    bool m_enabled{false};
+    QByteArray m_driver;
+    QString m_directory;
+};
+
+}
@@ -8,6 +8,7 @@
 #include "shader_manager.h"
 
 #include "platform.h"
+#include "program_cache.h"
 
 #include <como/base/logging.h>
 #include <como/render/effect/interface/paint_data.h>
@@ -37,6 +38,7 @@ void ShaderManager::cleanup()
 }
 
 ShaderManager::ShaderManager()
+    : m_programCache{std::make_unique<GLProgramCache>()}
 {
 }
 
@@ -188,13 +190,29 @@ std::unique_ptr<GLShader> ShaderManager::generateCustomShader(ShaderTraits trait
 #endif
 
     std::unique_ptr<GLShader> shader{new GLShader(GLShader::ExplicitLinking)};
+
+    QByteArray cacheKey;
+    if (m_programCache->isEnabled()) {
+        cacheKey = m_programCache->key(vertex, fragment);
+        if (m_programCache->load(shader->mProgram, cacheKey)) {
+            shader->mValid = true;
+            return shader;
+        }
+    }
+
     shader->load(vertex, fragment);
 
     shader->bindAttributeLocation("position", VA_Position);
     shader->bindAttributeLocation("texcoord", VA_TexCoord);
     shader->bindFragDataLocation("fragColor", 0);
 
-    shader->link();
+    if (!cacheKey.isEmpty()) {
+        glProgramParameteri(shader->mProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    if (shader->link() && !cacheKey.isEmpty()) {
+        m_programCache->store(shader->mProgram, cacheKey);
+    }
     return shader;
 }
 
@@ -262,6 +280,18 @@ GLShader* ShaderManager::shader(ShaderTraits traits)
     return shader.get();
 }
 
+void ShaderManager::warmUp()
+{
+    for (auto traits : {ShaderTraits(ShaderTrait::MapTexture),
+                        ShaderTrait::MapTexture | ShaderTrait::Modulate,
+                        ShaderTrait::MapTexture | ShaderTrait::Modulate
+                            | ShaderTrait::AdjustSaturation,
+                        ShaderTrait::MapTexture | ShaderTrait::AdjustSaturation,
+                        ShaderTraits(ShaderTrait::UniformColor)}) {
+        shader(traits);
+    }
+}
+
 GLShader* ShaderManager::getBoundShader() const
 {
     if (m_boundShaders.empty()) {
@@ -20,6 +20,7 @@
 namespace como
 {
 
+class GLProgramCache;
 class GLShader;
 
 enum class ShaderTrait {
@@ -141,6 +142,12 @@ public:
                                                      const QString& vertexFile = QString(),
                                                      const QString& fragmentFile = QString());
 
+    /**
+     * Generates the shaders for the trait combinations used by the compositing scene in advance,
+     * so the first frames do not stall on shader compilation.
+     */
+    void warmUp();
+
     /**
      * @return a pointer to the ShaderManager instance
      */
@@ -164,6 +171,7 @@ private:
 
     std::stack<GLShader*> m_boundShaders;
     std::map<ShaderTraits, std::unique_ptr<GLShader>> m_shaderHash;
+    std::unique_ptr<GLProgramCache> m_programCache;
     static ShaderManager* s_shaderManager;
 };
 
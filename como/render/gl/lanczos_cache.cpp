@@ -0,0 +1,17 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "lanczos_cache.h"
+
+namespace como::render::gl
+{
+
+EffectWindowDataSlot<lanczos_cache_entry*> const& lanczos_cache_slot()
+{
+    static EffectWindowDataSlot<lanczos_cache_entry*> slot;
+    return slot;
+}
+
+}
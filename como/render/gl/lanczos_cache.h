@@ -0,0 +1,180 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/render/effect/interface/effect_window.h>
+#include <como/render/gl/interface/texture.h>
+#include <como_export.h>
+
+#include <QtGlobal>
+#include <list>
+#include <memory>
+
+namespace como::render::gl
+{
+
+class lanczos_cache;
+
+struct lanczos_cache_entry {
+    EffectWindow* window;
+    std::unique_ptr<GLTexture> texture;
+
+    /// The window was damaged since the texture was filtered.
+    bool damaged{false};
+    /// Number of paints with the outdated texture since the window was damaged.
+    int stale_paints{0};
+
+    lanczos_cache* cache;
+    std::list<lanczos_cache_entry>::iterator position;
+};
+
+/// Slot of the scene for the cache entry of a window.
+COMO_EXPORT EffectWindowDataSlot<lanczos_cache_entry*> const& lanczos_cache_slot();
+
+/**
+ * Scaled window textures of the Lanczos filter. Textures are evicted in least-recently-painted
+ * order once they exceed the memory budget.
+ *
+ * A damaged window is not filtered again on its next paint. Its outdated texture is painted
+ * instead until the regeneration budget of a frame allows a new one, or at most for a fixed
+ * number of paints. This spreads the filtering of many constantly damaged windows over frames.
+ * Painting an outdated texture schedules another repaint of it, so it is always replaced.
+ *
+ * Limits can be set through the environment:
+ * - KWIN_GL_LANCZOS_CACHE_SIZE: memory budget in MiB, default 64
+ * - KWIN_GL_LANCZOS_MAX_STALE_PAINTS: maximum paints with an outdated texture, default 3
+ * - KWIN_GL_LANCZOS_UPDATES_PER_FRAME: textures filtered per frame before deferring, default 4
+ */
+class lanczos_cache
+{
+public:
+    lanczos_cache()
+    {
+        auto read_env = [](char const* name, int fallback) {
+            bool ok;
+            auto const value = qEnvironmentVariableIntValue(name, &ok);
+            return ok && value >= 0 ? value : fallback;
+        };
+
+        budget = static_cast<size_t>(read_env("KWIN_GL_LANCZOS_CACHE_SIZE", 64)) << 20;
+        max_stale_paints = read_env("KWIN_GL_LANCZOS_MAX_STALE_PAINTS", 3);
+        max_updates_per_frame = read_env("KWIN_GL_LANCZOS_UPDATES_PER_FRAME", 4);
+    }
+
+    ~lanczos_cache()
+    {
+        clear();
+    }
+
+    lanczos_cache(lanczos_cache const&) = delete;
+    lanczos_cache& operator=(lanczos_cache const&) = delete;
+
+    static lanczos_cache_entry* get(EffectWindow& window)
+    {
+        auto entry = window.slotData(lanczos_cache_slot());
+        return entry ? *entry : nullptr;
+    }
+
+    /// Marks the texture of @p window as outdated.
+    static void damage(EffectWindow& window)
+    {
+        if (auto entry = get(window)) {
+            entry->damaged = true;
+        }
+    }
+
+    /// Removes the texture of @p window. Must be called before the window is destroyed.
+    static void release(EffectWindow& window)
+    {
+        if (auto entry = get(window)) {
+            entry->cache->remove(*entry);
+        }
+    }
+
+    void start_frame()
+    {
+        updates_in_frame = 0;
+    }
+
+    /**
+     * Decides if the texture of @p entry must be filtered again before it is painted. Otherwise
+     * the texture is painted and the entry is marked as most recently used.
+     */
+    bool needs_update(lanczos_cache_entry& entry)
+    {
+        if (entry.damaged
+            && (entry.stale_paints >= max_stale_paints
+                || updates_in_frame < max_updates_per_frame)) {
+            updates_in_frame++;
+            return true;
+        }
+
+        if (entry.damaged) {
+            entry.stale_paints++;
+        }
+
+        entries.splice(entries.end(), entries, entry.position);
+        return false;
+    }
+
+    void store(EffectWindow& window, std::unique_ptr<GLTexture> texture)
+    {
+        auto const bytes = texture_size(*texture);
+
+        if (auto entry = get(window)) {
+            used -= texture_size(*entry->texture);
+            entry->texture = std::move(texture);
+            entry->damaged = false;
+            entry->stale_paints = 0;
+            entries.splice(entries.end(), entries, entry->position);
+        } else {
+            auto& added = entries.emplace_back();
+            added.window = &window;
+            added.texture = std::move(texture);
+            added.cache = this;
+            added.position = std::prev(entries.end());
+            window.setSlotData(lanczos_cache_slot(), &added);
+        }
+
+        used += bytes;
+
+        // Evict least recently painted textures but always keep the new one.
+        while (used > budget && entries.size() > 1) {
+            remove(entries.front());
+        }
+    }
+
+    void remove(lanczos_cache_entry& entry)
+    {
+        used -= texture_size(*entry.texture);
+        entry.window->resetSlotData(lanczos_cache_slot());
+        entries.erase(entry.position);
+    }
+
+    /// Must be called with the context current.
+    void clear()
+    {
+        while (!entries.empty()) {
+            remove(entries.front());
+        }
+    }
+
+    size_t budget;
+    int max_stale_paints;
+    int max_updates_per_frame;
+
+private:
+    static size_t texture_size(GLTexture const& texture)
+    {
+        return static_cast<size_t>(texture.width()) * texture.height() * 4;
+    }
+
+    std::list<lanczos_cache_entry> entries;
+    size_t used{0};
+    int updates_in_frame{0};
+};
+
+}
@@ -7,6 +7,8 @@
 */
 #pragma once
 
+#include "lanczos_cache.h"
+
 #include <como/render/types.h>
 #include <como/win/window_area.h>
 
@@ -25,6 +27,7 @@
 #include <QtMath>
 #include <array>
 #include <cmath>
+#include <memory>
 
 namespace como::render::gl
 {
@@ -51,6 +54,11 @@ public:
         delete m_offscreenTex;
     }
 
+    void start_frame()
+    {
+        m_cache.start_frame();
+    }
+
     template<typename EffWinImpl>
     void performPaint(EffWinImpl& eff_win, paint_type mask, effect::window_paint_data& data)
     {
@@ -101,11 +109,12 @@ public:
             scissor = data.paint.region;
         }
 
-        auto cachedTexture
-            = static_cast<GLTexture*>(eff_win.data(LanczosCacheRole).template value<void*>());
+        auto cacheEntry = lanczos_cache::get(eff_win);
 
-        if (cachedTexture) {
-            if (cachedTexture->width() == tw && cachedTexture->height() == th) {
+        if (cacheEntry) {
+            auto cachedTexture = cacheEntry->texture.get();
+            if (cachedTexture->width() == tw && cachedTexture->height() == th
+                && !m_cache.needs_update(*cacheEntry)) {
                 cachedTexture->bind();
                 glEnable(GL_BLEND);
                 glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
@@ -126,13 +135,15 @@ public:
                 cachedTexture->render(data.render, scissor, textureRect.size());
                 glDisable(GL_BLEND);
                 cachedTexture->unbind();
+
+                if (cacheEntry->damaged) {
+                    // The texture is outdated. Paint the thumbnail again, so it is updated even
+                    // when nothing else repaints it.
+                    m_scene->platform.addRepaint(textureRect);
+                }
+
                 m_timer.start(5000, this);
                 return;
-            } else {
-                // offscreen texture not matching - delete
-                delete cachedTexture;
-                cachedTexture = nullptr;
-                eff_win.setData(LanczosCacheRole, QVariant());
             }
         }
 
@@ -273,7 +284,7 @@ public:
         ShaderManager::instance()->popShader();
 
         // create cache texture
-        auto cache = new GLTexture(GL_RGBA8, tw, th);
+        auto cache = std::make_unique<GLTexture>(GL_RGBA8, tw, th);
 
         cache->setFilter(GL_LINEAR);
         cache->setWrapMode(GL_CLAMP_TO_EDGE);
@@ -300,7 +311,7 @@ public:
         glDisable(GL_BLEND);
 
         cache->unbind();
-        eff_win.setData(LanczosCacheRole, QVariant::fromValue(static_cast<void*>(cache)));
+        m_cache.store(eff_win, std::move(cache));
 
         // Delete the offscreen surface after 5 seconds
         m_timer.start(5000, this);
@@ -319,11 +330,7 @@ protected:
             m_offscreenTarget = nullptr;
             m_offscreenTex = nullptr;
 
-            for (auto win : m_scene->platform.base.mod.space->windows) {
-                std::visit(
-                    overload{[&](auto&& win) { discardCacheTexture(win->render->effect.get()); }},
-                    win);
-            }
+            m_cache.clear();
 
             m_scene->doneOpenGLContextCurrent();
         }
@@ -402,15 +409,6 @@ private:
         glUniform4fv(m_uKernel, m_kernel.size(), reinterpret_cast<const GLfloat*>(m_kernel.data()));
     }
 
-    void discardCacheTexture(EffectWindow* w)
-    {
-        QVariant cachedTextureVariant = w->data(LanczosCacheRole);
-        if (cachedTextureVariant.isValid()) {
-            delete static_cast<GLTexture*>(cachedTextureVariant.value<void*>());
-            w->setData(LanczosCacheRole, QVariant());
-        }
-    }
-
     void createKernel(float delta, int* size)
     {
 
@@ -474,6 +472,7 @@ private:
     std::array<QVector2D, 16> m_offsets;
     std::array<QVector4D, 16> m_kernel;
     Scene* m_scene;
+    lanczos_cache m_cache;
 };
 
 }
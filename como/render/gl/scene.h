@@ -23,6 +23,7 @@ SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <KNotification>
 #include <memory>
+#include <optional>
 #include <unistd.h>
 #include <unordered_map>
 
@@ -80,6 +81,13 @@ public:
             glBindVertexArray(vao);
         }
 
+        // Build the scene shaders now, likely from the program cache, instead of in the first
+        // frames.
+        if (!qEnvironmentVariableIsSet("KWIN_GL_SHADER_WARMUP")
+            || qEnvironmentVariableIntValue("KWIN_GL_SHADER_WARMUP") != 0) {
+            ShaderManager::instance()->warmUp();
+        }
+
         qCDebug(KWIN_CORE) << "OpenGL 2 compositing successfully initialized";
     }
 
@@ -89,6 +97,7 @@ public:
 
         // Need to reset early, otherwise the GL context is gone.
         sw_cursor.texture.reset();
+        deco_textures.clear();
 
         if (lanczos) {
             delete lanczos;
@@ -100,13 +109,18 @@ public:
         }
     }
 
-    int64_t paint_output(output_t* output,
-                         QRegion damage,
-                         std::deque<typename window_t::ref_t> const& ref_wins,
-                         std::chrono::milliseconds presentTime) override
+    std::optional<int64_t> paint_output(output_t* output,
+                                        QRegion damage,
+                                        std::deque<typename window_t::ref_t> const& ref_wins,
+                                        std::chrono::milliseconds presentTime) override
     {
         this->createStackingOrder(get_leads(ref_wins));
 
+        if (try_direct_scanout(output)) {
+            this->clearStackingOrder();
+            return {};
+        }
+
         m_backend->startRenderTimer();
 
         // Makes context current on the output.
@@ -114,11 +128,14 @@ public:
         auto const repaint = m_backend->get_output_render_region(*output);
 
         GLVertexBuffer::streamingBuffer()->beginFrame();
+        if (lanczos) {
+            lanczos->start_frame();
+        }
 
         GLenum const status = glGetGraphicsResetStatus();
         if (status != GL_NO_ERROR) {
             handleGraphicsReset(status);
-            return 0;
+            return {};
         }
 
         auto mask = paint_type::none;
@@ -272,6 +289,7 @@ public:
     }
 
     std::unordered_map<uint32_t, gl_window_t*> windows;
+    deco_texture_pool deco_textures;
 
 protected:
     std::unique_ptr<window_t> createWindow(typename window_t::ref_t ref_win) override
@@ -366,6 +384,43 @@ protected:
         }
     }
 
+    bool is_cursor_painted_on(output_t const& output) const
+    {
+        if constexpr (requires(decltype(this->platform) platform) { platform.software_cursor; }) {
+            auto cursor = this->platform.software_cursor.get();
+            auto const& input_cursor = this->platform.base.mod.space->input->cursor;
+
+            if (!cursor->enabled || input_cursor->is_hidden() || cursor->image().isNull()) {
+                return false;
+            }
+
+            auto const cursor_geo
+                = QRect(input_cursor->pos() - cursor->hotspot(), cursor->image().size());
+            return cursor_geo.intersects(output.geometry());
+        }
+        return false;
+    }
+
+    /**
+     * Presents a single fullscreen window directly, skipping the composition of the frame. This
+     * avoids the full-screen copy and a GPU pass on the output.
+     */
+    bool try_direct_scanout(output_t* output)
+    {
+        static bool const disabled = qgetenv("KWIN_DIRECT_SCANOUT") == QByteArrayLiteral("0");
+        if (disabled || is_cursor_painted_on(*output)) {
+            return false;
+        }
+
+        auto candidate = this->direct_scanout_candidate(*output);
+        if (!candidate || !m_backend->direct_scanout(output, *candidate)) {
+            return false;
+        }
+
+        this->skip_window_repaints(*output);
+        return true;
+    }
+
     void paintBackground(QRegion const& region, QMatrix4x4 const& projection) override
     {
         PaintClipper pc(region);
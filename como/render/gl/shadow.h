@@ -10,6 +10,7 @@
 #include <como/render/gl/interface/platform.h>
 #include <como/render/gl/interface/utils.h>
 
+#include <QMultiHash>
 #include <QPainter>
 #include <QSharedPointer>
 
@@ -84,6 +85,75 @@ private:
     QHash<KDecoration2::DecorationShadow*, Data> m_cache;
 };
 
+/**
+ * Shares the textures of shadows that are not provided by a decoration, like the ones of menus
+ * and panels. Such shadows are set per window but mostly consist of the same images. Entries
+ * are looked up by a hash of the composed shadow image and compared by content.
+ */
+template<typename Shadow>
+class ShadowTextureCache
+{
+public:
+    ~ShadowTextureCache()
+    {
+        assert(m_cache.isEmpty());
+    }
+
+    ShadowTextureCache(const ShadowTextureCache&) = delete;
+
+    static ShadowTextureCache& instance()
+    {
+        static ShadowTextureCache s_instance;
+        return s_instance;
+    }
+
+    void unregister(Shadow* shadow)
+    {
+        auto it = m_cache.begin();
+        while (it != m_cache.end()) {
+            auto& d = it.value();
+            d.shadows.removeAll(shadow);
+            if (d.shadows.isEmpty()) {
+                it = m_cache.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+
+    /// The @p create callback is only called when no texture with the content of @p image exists.
+    template<typename Create>
+    QSharedPointer<GLTexture> getTexture(Shadow* shadow, QImage const& image, Create create)
+    {
+        unregister(shadow);
+
+        auto const key = qHashBits(image.constBits(), image.sizeInBytes(), image.width());
+        auto [it, end] = m_cache.equal_range(key);
+        for (; it != end; it++) {
+            if (it.value().image == image) {
+                it.value().shadows << shadow;
+                return it.value().texture;
+            }
+        }
+
+        Data d;
+        d.image = image;
+        d.texture = create();
+        d.shadows << shadow;
+        m_cache.insert(key, d);
+        return d.texture;
+    }
+
+private:
+    ShadowTextureCache() = default;
+    struct Data {
+        QImage image;
+        QSharedPointer<GLTexture> texture;
+        QVector<Shadow*> shadows;
+    };
+    QMultiHash<size_t, Data> m_cache;
+};
+
 template<typename Window, typename Scene>
 class shadow : public render::shadow<Window>
 {
@@ -100,6 +170,7 @@ public:
     {
         scene.makeOpenGLContextCurrent();
         DecorationShadowTextureCache<type>::instance().unregister(this);
+        ShadowTextureCache<type>::instance().unregister(this);
         m_texture.reset();
     }
 
@@ -348,6 +419,7 @@ protected:
         if (this->hasDecorationShadow()) {
             // simplifies a lot by going directly to
             scene.makeOpenGLContextCurrent();
+            ShadowTextureCache<type>::instance().unregister(this);
             m_texture = DecorationShadowTextureCache<type>::instance().getTexture(this);
 
             return true;
@@ -441,13 +513,17 @@ protected:
         }
 
         scene.makeOpenGLContextCurrent();
-        m_texture = QSharedPointer<GLTexture>::create(image);
+        DecorationShadowTextureCache<type>::instance().unregister(this);
+        m_texture = ShadowTextureCache<type>::instance().getTexture(this, image, [&image] {
+            auto texture = QSharedPointer<GLTexture>::create(image);
 
-        if (m_texture->internalFormat() == GL_R8) {
-            // Swizzle red to alpha and all other channels to zero
-            m_texture->bind();
-            m_texture->setSwizzle(GL_ZERO, GL_ZERO, GL_ZERO, GL_RED);
-        }
+            if (texture->internalFormat() == GL_R8) {
+                // Swizzle red to alpha and all other channels to zero
+                texture->bind();
+                texture->setSwizzle(GL_ZERO, GL_ZERO, GL_ZERO, GL_RED);
+            }
+            return texture;
+        });
 
         return true;
     }
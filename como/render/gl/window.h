@@ -19,7 +19,11 @@
 
 #include <QMatrix4x4>
 #include <QVector4D>
+#include <array>
 #include <cmath>
+#include <memory>
+#include <span>
+#include <vector>
 
 namespace como::render::gl
 {
@@ -106,48 +110,17 @@ public:
         shader->setUniform(GLShader::ModelViewProjectionMatrix, effect::get_mvp(data) * pos_matrix);
         shader->setUniform(GLShader::Saturation, data.paint.saturation);
 
-        std::vector<WindowQuadList> quads;
-        quads.resize(ContentLeaf + 1);
-        int last_content_id = this->id();
-
-        // TODO: remove again once we are sure that content ids never repeat.
-        auto content_ids = std::vector<int>{last_content_id};
-
-        // Split the quads into separate lists for each type
-        for (auto const& quad : std::as_const(data.quads)) {
-            switch (quad.type()) {
-            case WindowQuadShadow:
-                quads[ShadowLeaf].append(quad);
-                continue;
-
-            case WindowQuadDecoration:
-                quads[DecorationLeaf].append(quad);
-                continue;
-
-            case WindowQuadContents:
-                if (last_content_id != quad.id()) {
-                    assert(!contains(content_ids, quad.id()));
-                    // Content quads build chains in the list so an id never repeats itself.
-                    quads.resize(quads.size() + 1);
-                    last_content_id = quad.id();
-                }
-                quads.back().append(quad);
-                continue;
+        auto& quads = split_quads(data);
+        auto has_previous_content = false;
 
-            default:
-                continue;
-            }
-        }
-
-        bool has_previous_content = false;
         if (data.cross_fade_progress != 1.0) {
             auto previous = this->template previous_buffer<buffer_t>();
             if (previous) {
                 has_previous_content = true;
-                quads.resize(quads.size() + 1);
+                auto& previous_quads = add_leaf();
                 auto const& old_content_rect = previous->win_integration->get_contents_rect();
 
-                for (auto const& quad : std::as_const(quads[ContentLeaf])) {
+                for (auto const& quad : std::as_const(paint_scratch.quads[ContentLeaf])) {
                     if (quad.id() != static_cast<int>(this->id())) {
                         // We currently only do this for the main window and not annexed children
                         // that means we can skip from here on.
@@ -187,44 +160,21 @@ public:
                         newQuad[i] = vertex;
                     }
 
-                    quads.back().append(newQuad);
+                    previous_quads.append(newQuad);
                 }
             }
         }
 
-        const bool indexedQuads = GLVertexBuffer::supportsIndexedQuads();
-        const GLenum primitiveType = indexedQuads ? GL_QUADS : GL_TRIANGLES;
-        const int verticesPerQuad = indexedQuads ? 4 : 6;
+        auto const leaves = std::span(quads.data(), paint_scratch.leaf_count);
 
-        int quad_count = 0;
-        for (auto const& quad_list : quads) {
-            quad_count += quad_list.size();
-        }
+        auto& nodes = paint_scratch.nodes;
+        setupLeafNodes(nodes, leaves, has_previous_content, data);
 
-        GLVertexBuffer* vbo = GLVertexBuffer::streamingBuffer();
-        auto map = vbo->map<GLVertex2D>(verticesPerQuad * quad_count);
-        if (!map) {
-            qCWarning(KWIN_CORE) << "Could not map vertices to perform paint";
+        auto vbo = upload_vertices(leaves, nodes, data, has_previous_content);
+        if (!vbo) {
             return;
         }
 
-        std::vector<LeafNode> nodes;
-        setupLeafNodes(nodes, quads, has_previous_content, data);
-
-        for (size_t i = 0, v = 0; i < quads.size(); i++) {
-            if (quads[i].isEmpty() || !nodes[i].texture)
-                continue;
-
-            nodes[i].firstVertex = v;
-            nodes[i].vertexCount = quads[i].count() * verticesPerQuad;
-
-            const QMatrix4x4 matrix = nodes[i].texture->matrix(nodes[i].coordinateType);
-
-            quads[i].makeInterleavedArrays(primitiveType, (*map).subspan(v), matrix);
-            v += quads[i].count() * verticesPerQuad;
-        }
-
-        vbo->unmap();
         vbo->bindArrays();
 
         // Make sure the blend function is set up correctly in case we will be doing blending
@@ -238,7 +188,7 @@ public:
             scissorRegion = data.paint.region;
         }
 
-        for (size_t i = 0; i < quads.size(); i++) {
+        for (size_t i = 0; i < leaves.size(); i++) {
             if (nodes[i].vertexCount == 0)
                 continue;
 
@@ -256,7 +206,7 @@ public:
 
             vbo->draw(data.render,
                       scissorRegion,
-                      primitiveType,
+                      primitive_type(),
                       nodes[i].firstVertex,
                       nodes[i].vertexCount);
         }
@@ -321,11 +271,11 @@ private:
     }
 
     void setupLeafNodes(std::vector<LeafNode>& nodes,
-                        std::vector<WindowQuadList> const& quads,
+                        std::span<WindowQuadList const> quads,
                         bool has_previous_content,
                         effect::window_paint_data const& data)
     {
-        nodes.resize(quads.size());
+        nodes.assign(quads.size(), LeafNode());
 
         if (!quads[ShadowLeaf].isEmpty()) {
             nodes[ShadowLeaf].texture
@@ -391,6 +341,182 @@ private:
         }
     }
 
+    static bool indexed_quads()
+    {
+        return GLVertexBuffer::supportsIndexedQuads();
+    }
+
+    static GLenum primitive_type()
+    {
+        return indexed_quads() ? GL_QUADS : GL_TRIANGLES;
+    }
+
+    static int vertices_per_quad()
+    {
+        return indexed_quads() ? 4 : 6;
+    }
+
+    /// Returns a cleared quad list for the next leaf.
+    WindowQuadList& add_leaf()
+    {
+        auto& quads = paint_scratch.quads;
+        auto const index = paint_scratch.leaf_count++;
+
+        if (index == quads.size()) {
+            quads.emplace_back();
+        } else {
+            // Keeps the capacity of the list.
+            quads[index].clear();
+        }
+
+        return quads[index];
+    }
+
+    /// Splits the quads into separate lists for each leaf. Content quads of annexed children
+    /// get a leaf each.
+    std::vector<WindowQuadList>& split_quads(effect::window_paint_data const& data)
+    {
+        paint_scratch.leaf_count = 0;
+        for (int leaf = 0; leaf <= ContentLeaf; leaf++) {
+            add_leaf();
+        }
+
+        auto& quads = paint_scratch.quads;
+        auto const own_content_id = static_cast<int>(this->id());
+        auto last_content_id = own_content_id;
+        auto content_leaf = static_cast<size_t>(ContentLeaf);
+
+        for (auto const& quad : std::as_const(data.quads)) {
+            switch (quad.type()) {
+            case WindowQuadShadow:
+                quads[ShadowLeaf].append(quad);
+                continue;
+
+            case WindowQuadDecoration:
+                quads[DecorationLeaf].append(quad);
+                continue;
+
+            case WindowQuadContents:
+                if (last_content_id != quad.id()) {
+                    // TODO: remove again once we are sure that content ids never repeat.
+                    assert(quad.id() != own_content_id);
+                    // Content quads build chains in the list so an id never repeats itself.
+                    add_leaf();
+                    content_leaf = paint_scratch.leaf_count - 1;
+                    last_content_id = quad.id();
+                }
+                quads[content_leaf].append(quad);
+                continue;
+
+            default:
+                continue;
+            }
+        }
+
+        return quads;
+    }
+
+    /**
+     * Writes the vertices of all leaves to a vertex buffer and returns it with arrays not yet
+     * bound. With KWIN_GL_STATIC_WINDOW_VBO=1 vertices are kept in a buffer owned by the window
+     * and are only uploaded again when the quads or texture matrices changed.
+     */
+    GLVertexBuffer* upload_vertices(std::span<WindowQuadList const> quads,
+                                    std::vector<LeafNode>& nodes,
+                                    effect::window_paint_data const& data,
+                                    bool has_previous_content)
+    {
+        static bool const use_static_vbo
+            = qEnvironmentVariableIntValue("KWIN_GL_STATIC_WINDOW_VBO") == 1;
+
+        auto& matrices = paint_scratch.matrices;
+        matrices.clear();
+
+        int quad_count = 0;
+        for (size_t i = 0; i < quads.size(); i++) {
+            if (quads[i].isEmpty() || !nodes[i].texture) {
+                matrices.emplace_back();
+                continue;
+            }
+            quad_count += quads[i].count();
+            matrices.push_back(nodes[i].texture->matrix(nodes[i].coordinateType));
+        }
+
+        auto const set_ranges = [&] {
+            for (size_t i = 0, v = 0; i < quads.size(); i++) {
+                if (quads[i].isEmpty() || !nodes[i].texture) {
+                    continue;
+                }
+                nodes[i].firstVertex = v;
+                nodes[i].vertexCount = quads[i].count() * vertices_per_quad();
+                v += nodes[i].vertexCount;
+            }
+        };
+
+        auto const write_vertices = [&](std::span<GLVertex2D> vertices) {
+            for (size_t i = 0; i < quads.size(); i++) {
+                if (nodes[i].vertexCount == 0) {
+                    continue;
+                }
+                quads[i].makeInterleavedArrays(
+                    primitive_type(), vertices.subspan(nodes[i].firstVertex), matrices[i]);
+            }
+        };
+
+        set_ranges();
+
+        if (!use_static_vbo || has_previous_content) {
+            auto vbo = GLVertexBuffer::streamingBuffer();
+            auto map = vbo->map<GLVertex2D>(vertices_per_quad() * quad_count);
+            if (!map) {
+                qCWarning(KWIN_CORE) << "Could not map vertices to perform paint";
+                return nullptr;
+            }
+            write_vertices(*map);
+            vbo->unmap();
+            return vbo;
+        }
+
+        auto& cache = vertex_cache;
+
+        // The quads are implicitly shared with the window's quad cache. As long as that one is
+        // not rebuilt and no effect modified them, the data pointer stays the same.
+        if (cache.vbo && cache.quads.constData() == data.quads.constData()
+            && cache.quads.size() == data.quads.size() && cache.matrices == matrices) {
+            return cache.vbo.get();
+        }
+
+        if (!cache.vbo) {
+            cache.vbo = std::make_unique<GLVertexBuffer>(GLVertexBuffer::Static);
+            cache.vbo->setAttribLayout(std::span(vertex_layout), sizeof(GLVertex2D));
+        }
+
+        auto& vertices = paint_scratch.vertices;
+        vertices.resize(vertices_per_quad() * quad_count);
+        write_vertices(vertices);
+
+        cache.vbo->setData(vertices.data(), vertices.size() * sizeof(GLVertex2D));
+        cache.quads = data.quads;
+        cache.matrices = matrices;
+
+        return cache.vbo.get();
+    }
+
+    static constexpr std::array vertex_layout{
+        GLVertexAttrib{
+            .attributeIndex = VA_Position,
+            .componentCount = 2,
+            .type = GL_FLOAT,
+            .relativeOffset = offsetof(GLVertex2D, position),
+        },
+        GLVertexAttrib{
+            .attributeIndex = VA_TexCoord,
+            .componentCount = 2,
+            .type = GL_FLOAT,
+            .relativeOffset = offsetof(GLVertex2D, texcoord),
+        },
+    };
+
     bool beginRenderWindow(paint_type mask, effect::window_paint_data& data)
     {
         if (data.paint.region.isEmpty()) {
@@ -457,22 +583,7 @@ private:
 
         auto vbo = GLVertexBuffer::streamingBuffer();
         vbo->reset();
-
-        constexpr std::array layout{
-            GLVertexAttrib{
-                .attributeIndex = VA_Position,
-                .componentCount = 2,
-                .type = GL_FLOAT,
-                .relativeOffset = offsetof(GLVertex2D, position),
-            },
-            GLVertexAttrib{
-                .attributeIndex = VA_TexCoord,
-                .componentCount = 2,
-                .type = GL_FLOAT,
-                .relativeOffset = offsetof(GLVertex2D, texcoord),
-            },
-        };
-        vbo->setAttribLayout(std::span(layout), sizeof(GLVertex2D));
+        vbo->setAttribLayout(std::span(vertex_layout), sizeof(GLVertex2D));
 
         return true;
     }
@@ -498,6 +609,23 @@ private:
         return buffer->texture.get();
     }
 
+    /// Storage reused between paints to not allocate on every paint.
+    struct {
+        /// Quads split up by leaf. Only the first leaf_count lists are in use.
+        std::vector<WindowQuadList> quads;
+        size_t leaf_count{0};
+        std::vector<LeafNode> nodes;
+        std::vector<QMatrix4x4> matrices;
+        std::vector<GLVertex2D> vertices;
+    } paint_scratch;
+
+    /// Vertices of the last paint when vertices are kept in a static buffer.
+    struct {
+        std::unique_ptr<GLVertexBuffer> vbo;
+        WindowQuadList quads;
+        std::vector<QMatrix4x4> matrices;
+    } vertex_cache;
+
     bool m_hardwareClipping{false};
     bool m_blendingEnabled{false};
     Scene& scene;
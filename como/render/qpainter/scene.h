@@ -40,10 +40,10 @@ public:
         QQuickWindow::setSceneGraphBackend("software");
     }
 
-    int64_t paint_output(output_t* output,
-                         QRegion damage,
-                         std::deque<typename window_t::ref_t> const& ref_wins,
-                         std::chrono::milliseconds presentTime) override
+    std::optional<int64_t> paint_output(output_t* output,
+                                        QRegion damage,
+                                        std::deque<typename window_t::ref_t> const& ref_wins,
+                                        std::chrono::milliseconds presentTime) override
     {
         QElapsedTimer renderTimer;
         renderTimer.start();
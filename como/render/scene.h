@@ -23,8 +23,11 @@ SPDX-License-Identifier: GPL-2.0-or-later
 #include <QMatrix4x4>
 #include <QQuickWindow>
 #include <chrono>
+#include <algorithm>
 #include <deque>
 #include <memory>
+#include <optional>
+#include <tuple>
 
 namespace como::render
 {
@@ -101,10 +104,15 @@ public:
 
     virtual bool isOpenGl() const = 0;
 
-    virtual int64_t paint_output(output_t* /*output*/,
-                                 QRegion /*damage*/,
-                                 std::deque<typename window_t::ref_t> const& /*ref_wins*/,
-                                 std::chrono::milliseconds /*presentTime*/)
+    /**
+     * Paints a frame on @p output.
+     * @returns the time it took in nanoseconds, or nothing when no frame was composited.
+     */
+    virtual std::optional<int64_t>
+    paint_output(output_t* /*output*/,
+                 QRegion /*damage*/,
+                 std::deque<typename window_t::ref_t> const& /*ref_wins*/,
+                 std::chrono::milliseconds /*presentTime*/)
     {
         assert(false);
         return 0;
@@ -220,6 +228,57 @@ public:
         stacking_order.clear();
     }
 
+    /**
+     * Returns the window whose buffer can be presented on @p output without composition. That is
+     * an opaque fullscreen window covering the output with nothing on top of it and no effect
+     * that might change how it is painted.
+     */
+    window_t* direct_scanout_candidate(output_t const& output) const
+    {
+        auto const output_geo = output.geometry();
+
+        for (auto it = stacking_order.crbegin(); it != stacking_order.crend(); ++it) {
+            auto win = *it;
+            if (!win->isPaintingEnabled()) {
+                continue;
+            }
+
+            auto const covers = std::visit(
+                overload{[&](auto&& ref_win) -> std::optional<bool> {
+                    if (!win::visible_rect(ref_win).intersects(output_geo)) {
+                        return std::nullopt;
+                    }
+                    if (!ref_win->control || !ref_win->control->fullscreen || !win->isOpaque()) {
+                        return false;
+                    }
+                    if (win::render_geometry(ref_win) != output_geo) {
+                        return false;
+                    }
+                    // Annexed children like subsurfaces are painted as part of the window.
+                    return std::none_of(ref_win->transient->children.cbegin(),
+                                        ref_win->transient->children.cend(),
+                                        [](auto child) { return child->transient->annexed; });
+                }},
+                *win->ref_win);
+
+            if (covers) {
+                return *covers && !platform.effects->affects_window(win->effect.get()) ? win
+                                                                                       : nullptr;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /// Consumes the repaints on @p output of all windows when no painting pass runs for it.
+    void skip_window_repaints(output_t const& output)
+    {
+        for (auto win : stacking_order) {
+            std::visit(overload{[&](auto&& ref_win) { win::reset_repaints(*ref_win, &output); }},
+                       *win->ref_win);
+        }
+    }
+
     // shared implementation, starts painting the screen
     void paintScreen(effect::render_data& render,
                      paint_type& mask,
@@ -401,6 +460,95 @@ public:
         damaged_region = QRegion(0, 0, space_size.width(), space_size.height());
     }
 
+    /**
+     * Region of @p ref_win that hides the windows below it and the mask it is painted with. The
+     * region only hides other windows if the mask does not contain
+     * paint_type::window_translucent.
+     */
+    template<typename RefWin>
+    std::tuple<QRegion, paint_type> get_window_clip(RefWin& ref_win, paint_type const orig_mask)
+    {
+        auto win = ref_win.render.get();
+        auto mask = orig_mask
+            | (win->isOpaque() ? paint_type::window_opaque : paint_type::window_translucent);
+        QRegion clip;
+
+        if (win->isOpaque()) {
+            clip = win::content_render_region(&ref_win).translated(ref_win.geo.pos()
+                                                                   + win->bufferOffset());
+        } else if (win::has_alpha(ref_win) && ref_win.opacity() == 1.0) {
+            auto const clientShape = win::content_render_region(&ref_win).translated(
+                win::frame_to_render_pos(&ref_win, ref_win.geo.pos()));
+            auto const opaqueShape = ref_win.render_data.opaque_region.translated(
+                win::frame_to_client_pos(&ref_win, ref_win.geo.pos()) - ref_win.geo.pos());
+            clip = clientShape & opaqueShape;
+            if (clientShape == opaqueShape) {
+                mask = orig_mask | paint_type::window_opaque;
+            }
+        }
+
+        // Clip out decoration without alpha when window has not set additional opacity by us.
+        // The decoration is drawn in the second pass.
+        if (ref_win.control && !win::decoration_has_alpha(&ref_win) && ref_win.opacity() == 1.0) {
+            clip = win->decorationShape().translated(ref_win.geo.pos());
+        }
+
+        return {clip, mask};
+    }
+
+    /**
+     * Marks the windows in the stacking order that are completely hidden behind opaque windows
+     * above them. These are neither prepared nor painted, so effect hooks and buffer updates are
+     * skipped for them. Effects may move, transform or fade windows while painting, hence windows
+     * affected by an effect are neither marked nor hide other windows.
+     */
+    void mark_occluded_windows(paint_type const orig_mask)
+    {
+        static bool const enabled = qEnvironmentVariableIntValue("KWIN_OCCLUSION_CULLING") != 0
+            || !qEnvironmentVariableIsSet("KWIN_OCCLUSION_CULLING");
+
+        occluded.assign(stacking_order.size(), false);
+
+        if (!enabled) {
+            return;
+        }
+
+        QRegion coverage;
+
+        // Top to bottom.
+        for (auto index = stacking_order.size(); index-- > 0;) {
+            auto win = stacking_order[index];
+            if (!win->isPaintingEnabled()) {
+                continue;
+            }
+
+            if (platform.effects->affects_window(win->effect.get())) {
+                continue;
+            }
+
+            std::visit(overload{[&](auto&& ref_win) {
+                           auto const has_annexed_children
+                               = std::any_of(ref_win->transient->children.cbegin(),
+                                             ref_win->transient->children.cend(),
+                                             [](auto child) { return child->transient->annexed; });
+
+                           // Annexed children are painted as part of the window, possibly
+                           // outside of its visible rect.
+                           if (!has_annexed_children && !coverage.isEmpty()
+                               && (QRegion(win::visible_rect(ref_win)) - coverage).isEmpty()) {
+                               occluded[index] = true;
+                               return;
+                           }
+
+                           auto const [clip, mask] = get_window_clip(*ref_win, orig_mask);
+                           if (!(mask & paint_type::window_translucent)) {
+                               coverage |= clip;
+                           }
+                       }},
+                       *win->ref_win);
+        }
+    }
+
     template<typename RefWin>
     void prepare_simple_window_paint(RefWin& ref_win,
                                      paint_type const orig_mask,
@@ -414,13 +562,12 @@ public:
             return;
         }
 
+        auto [clip, mask] = get_window_clip(ref_win, orig_mask);
+
         effect::window_prepaint_data data{
             .window = *win->effect,
-            .paint
-            = {.mask = static_cast<int>(orig_mask
-                                        | (win->isOpaque() ? paint_type::window_opaque
-                                                           : paint_type::window_translucent)),
-               .region = region | win::repaints(ref_win)},
+            .paint = {.mask = static_cast<int>(mask), .region = region | win::repaints(ref_win)},
+            .clip = clip,
             .present_time = m_expectedPresentTimestamp,
         };
 
@@ -432,29 +579,8 @@ public:
         opaqueFullscreen = false;
 
         // TODO: do we care about unmanged windows here (maybe input windows?)
-        if (win->isOpaque()) {
-            if (ref_win.control) {
-                opaqueFullscreen = ref_win.control->fullscreen;
-            }
-            data.clip |= win::content_render_region(&ref_win).translated(ref_win.geo.pos()
-                                                                         + win->bufferOffset());
-        } else if (win::has_alpha(ref_win) && ref_win.opacity() == 1.0) {
-            auto const clientShape = win::content_render_region(&ref_win).translated(
-                win::frame_to_render_pos(&ref_win, ref_win.geo.pos()));
-            auto const opaqueShape = ref_win.render_data.opaque_region.translated(
-                win::frame_to_client_pos(&ref_win, ref_win.geo.pos()) - ref_win.geo.pos());
-            data.clip = clientShape & opaqueShape;
-            if (clientShape == opaqueShape) {
-                data.paint.mask = static_cast<int>(orig_mask | paint_type::window_opaque);
-            }
-        } else {
-            data.clip = QRegion();
-        }
-
-        // Clip out decoration without alpha when window has not set additional opacity by us.
-        // The decoration is drawn in the second pass.
-        if (ref_win.control && !win::decoration_has_alpha(&ref_win) && ref_win.opacity() == 1.0) {
-            data.clip = win->decorationShape().translated(ref_win.geo.pos());
+        if (win->isOpaque() && ref_win.control) {
+            opaqueFullscreen = ref_win.control->fullscreen;
         }
 
         data.quads = win->buildQuads();
@@ -492,14 +618,26 @@ public:
         QRegion dirtyArea = region;
         bool opaqueFullscreen = false;
 
+        mark_occluded_windows(orig_mask);
+
         // Traverse the scene windows from bottom to top.
-        for (auto&& win : stacking_order) {
-            std::visit(
-                overload{[&](auto&& ref_win) {
-                    prepare_simple_window_paint(
-                        *ref_win, orig_mask, region, dirtyArea, opaqueFullscreen, phase2data);
-                }},
-                *win->ref_win);
+        for (size_t index = 0; index < stacking_order.size(); index++) {
+            std::visit(overload{[&](auto&& ref_win) {
+                           if (occluded[index]) {
+                               // Repaints are consumed to not accumulate. Their area is still
+                               // painted by the windows on top.
+                               dirtyArea |= win::repaints(*ref_win);
+                               win::reset_repaints(*ref_win, repaint_output);
+                               return;
+                           }
+                           prepare_simple_window_paint(*ref_win,
+                                                       orig_mask,
+                                                       region,
+                                                       dirtyArea,
+                                                       opaqueFullscreen,
+                                                       phase2data);
+                       }},
+                       *stacking_order[index]->ref_win);
         }
 
         // Save the part of the repaint region that's exclusively rendered to
@@ -671,6 +809,9 @@ private:
 
     // Windows stacking order of the current paint run.
     std::vector<window_t*> stacking_order;
+
+    /// Windows in the stacking order hidden by windows above them in the current paint pass.
+    std::vector<bool> occluded;
 };
 
 }
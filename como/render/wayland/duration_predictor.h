@@ -0,0 +1,161 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "duration_record.h"
+
+#include <QByteArray>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+
+namespace como::render::wayland
+{
+
+/**
+ * Histogram of durations where older values lose weight exponentially. A single outlier is
+ * therefore forgotten over time instead of being held as maximum for a fixed period.
+ */
+class duration_histogram
+{
+public:
+    static constexpr size_t bucket_count{128};
+    static constexpr std::chrono::nanoseconds bucket_width{std::chrono::microseconds(250)};
+
+    duration_histogram() = default;
+
+    /// @param decay factor with which the weight of all previous values is reduced on an update.
+    explicit duration_histogram(double decay)
+        : decay{decay}
+    {
+        assert(decay > 0 && decay <= 1);
+    }
+
+    void update(std::chrono::nanoseconds duration)
+    {
+        // Instead of decaying all buckets on every update we grow the weight of new values.
+        increment /= decay;
+
+        auto const index = std::min(
+            static_cast<size_t>(std::max<int64_t>(duration.count(), 0) / bucket_width.count()),
+            bucket_count - 1);
+        buckets[index] += increment;
+        total += increment;
+
+        if (index == bucket_count - 1) {
+            overflow_max = std::max(overflow_max, duration);
+        }
+
+        if (increment > rescale_limit) {
+            rescale();
+        }
+    }
+
+    /// Returns the upper bound of the bucket the @p percentile of weighted values falls into.
+    std::chrono::nanoseconds get_percentile(double percentile) const
+    {
+        assert(percentile >= 0 && percentile <= 1);
+
+        if (total <= 0) {
+            return std::chrono::nanoseconds::zero();
+        }
+
+        auto const target = percentile * total;
+        double sum{0};
+
+        for (size_t index = 0; index < bucket_count - 1; index++) {
+            sum += buckets[index];
+            if (sum >= target && buckets[index] > 0) {
+                return bucket_width * static_cast<int64_t>(index + 1);
+            }
+        }
+
+        return std::max(overflow_max, bucket_width * static_cast<int64_t>(bucket_count));
+    }
+
+private:
+    void rescale()
+    {
+        for (auto& bucket : buckets) {
+            bucket /= increment;
+        }
+        total /= increment;
+
+        if (buckets.back() < forget_limit) {
+            buckets.back() = 0;
+            overflow_max = std::chrono::nanoseconds::zero();
+        }
+
+        increment = 1;
+    }
+
+    static constexpr double rescale_limit{1e6};
+    static constexpr double forget_limit{1e-3};
+
+    double decay{0.995};
+    double increment{1};
+    double total{0};
+    std::array<double, bucket_count> buckets{};
+    std::chrono::nanoseconds overflow_max{0};
+};
+
+enum class duration_prediction_policy {
+    max,
+    p95,
+    p99,
+};
+
+inline duration_prediction_policy get_default_duration_prediction_policy()
+{
+    static auto const policy = [] {
+        auto const env = qgetenv("KWIN_FRAME_PREDICTION");
+        if (env == QByteArrayLiteral("max")) {
+            return duration_prediction_policy::max;
+        }
+        if (env == QByteArrayLiteral("p95")) {
+            return duration_prediction_policy::p95;
+        }
+        return duration_prediction_policy::p99;
+    }();
+
+    return policy;
+}
+
+/**
+ * Predicts the duration of the next frame from previous ones. All policies are fed continuously
+ * so the policy can be switched at any time.
+ */
+struct duration_predictor {
+    std::chrono::nanoseconds predict() const
+    {
+        switch (policy) {
+        case duration_prediction_policy::max:
+            return record.get_max();
+        case duration_prediction_policy::p95:
+            return histogram.get_percentile(0.95);
+        case duration_prediction_policy::p99:
+            return histogram.get_percentile(0.99);
+        }
+
+        assert(false);
+        return record.get_max();
+    }
+
+    void update(std::chrono::nanoseconds duration)
+    {
+        record.update(duration);
+        histogram.update(duration);
+    }
+
+    duration_prediction_policy policy{get_default_duration_prediction_policy()};
+
+private:
+    duration_record record;
+    duration_histogram histogram;
+};
+
+}
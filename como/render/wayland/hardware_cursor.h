@@ -0,0 +1,127 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <como/base/platform_qobject.h>
+
+#include <QObject>
+#include <memory>
+#include <type_traits>
+
+namespace como::render::wayland
+{
+
+/**
+ * Shows the cursor in the hardware cursor planes of the outputs. Pointer motion then only moves
+ * the planes and does not require compositing a frame.
+ *
+ * If any output can not show the current cursor image in a plane, the software cursor is used
+ * on all outputs until the next image change.
+ */
+template<typename Platform>
+class hardware_cursor
+{
+public:
+    explicit hardware_cursor(Platform& platform)
+        : qobject{std::make_unique<QObject>()}
+        , platform{platform}
+    {
+        auto cursor = get_cursor();
+        using cursor_t = std::remove_pointer_t<decltype(cursor)>;
+
+        cursor->start_image_tracking();
+        QObject::connect(cursor, &cursor_t::pos_changed, qobject.get(), [this] { move(); });
+        QObject::connect(cursor, &cursor_t::image_changed, qobject.get(), [this] { update(); });
+
+        QObject::connect(platform.base.qobject.get(),
+                         &base::platform_qobject::output_added,
+                         qobject.get(),
+                         [this] { update(); });
+        QObject::connect(platform.base.qobject.get(),
+                         &base::platform_qobject::topology_changed,
+                         qobject.get(),
+                         [this] { update(); });
+
+        update();
+    }
+
+    ~hardware_cursor()
+    {
+        get_cursor()->stop_image_tracking();
+        hide();
+    }
+
+    hardware_cursor(hardware_cursor const&) = delete;
+    hardware_cursor& operator=(hardware_cursor const&) = delete;
+
+    /// Whether the planes currently show the cursor instead of the software cursor.
+    bool active{false};
+
+private:
+    auto get_cursor()
+    {
+        return platform.base.mod.space->input->cursor.get();
+    }
+
+    void update()
+    {
+        auto cursor = get_cursor();
+        auto const image = cursor->image();
+
+        if (cursor->is_hidden() || image.isNull()) {
+            // The software cursor checks the same conditions on its own.
+            hide();
+            return;
+        }
+
+        auto const hotspot = cursor->hotspot();
+        active = true;
+
+        for (auto output : platform.base.outputs) {
+            if (!output->render->cursor.set_image(image, hotspot)) {
+                active = false;
+                break;
+            }
+        }
+
+        if (!active) {
+            hide();
+        }
+
+        platform.software_cursor->set_enabled(!active);
+
+        if (active) {
+            move();
+
+            // Lets clients with animated cursors continue.
+            cursor->mark_as_rendered();
+        }
+    }
+
+    void move()
+    {
+        if (!active) {
+            return;
+        }
+
+        auto const pos = get_cursor()->pos();
+        for (auto output : platform.base.outputs) {
+            output->render->cursor.move(pos);
+        }
+    }
+
+    void hide()
+    {
+        for (auto output : platform.base.outputs) {
+            output->render->cursor.hide();
+        }
+    }
+
+    std::unique_ptr<QObject> qobject;
+    Platform& platform;
+};
+
+}
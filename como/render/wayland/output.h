@@ -5,7 +5,8 @@
 */
 #pragma once
 
-#include "duration_record.h"
+#include "duration_predictor.h"
+#include "output_telemetry.h"
 #include "presentation.h"
 
 #include <como/base/logging.h>
@@ -102,6 +103,7 @@ public:
                                                     }
                                                     render_time_debug = timer.time();
                                                     render_durations.update(timer.time());
+                                                    telemetry.gpu.update(timer.time());
                                                     return true;
                                                 }),
                                  last_timer_queries.end());
@@ -121,8 +123,8 @@ public:
         auto const hw_margin = refresh / 10;
 
         // We try to delay the next paint shortly before next vblank factoring in our margins.
-        auto try_delay = refresh - vblank_to_now - hw_margin - paint_durations.get_max()
-            - render_durations.get_max();
+        auto try_delay = refresh - vblank_to_now - hw_margin - paint_durations.predict()
+            - render_durations.predict();
 
         // If our previous margins were too large we don't delay. We would likely miss the next
         // vblank.
@@ -135,8 +137,8 @@ public:
         debug << "vblank to now: " << to_ms(now) << " - " << to_ms(data.when) << " = "
               << to_ms(vblank_to_now) << endl;
         debug << "MARGINS vblank: " << to_ms(hw_margin)
-              << " paint: " << to_ms(paint_durations.get_max())
-              << " render: " << to_ms(render_time_debug) << "(" << to_ms(render_durations.get_max())
+              << " paint: " << to_ms(paint_durations.predict())
+              << " render: " << to_ms(render_time_debug) << "(" << to_ms(render_durations.predict())
               << ")" << endl;
         debug << "refresh: " << to_ms(refresh) << " delay: " << to_ms(try_delay) << " ("
               << to_ms(delay) << ")";
@@ -144,6 +146,13 @@ public:
 #endif
     }
 
+    /// Sets how paint and render durations of the next frame are predicted on this output.
+    void set_prediction_policy(duration_prediction_policy policy)
+    {
+        paint_durations.policy = policy;
+        render_durations.policy = policy;
+    }
+
     void set_delay_timer()
     {
         if (output_waiting_for_event(*this)) {
@@ -159,7 +168,9 @@ public:
         Perf::Ftrace::mark(ftrace_identifier + QString::number(wait_time.count()));
 
         // Force 4fps minimum:
-        delay_timer.start(std::min(wait_time, std::chrono::milliseconds(250)).count(), this);
+        auto const timeout = std::min(wait_time, std::chrono::milliseconds(250));
+        telemetry.planned_run = std::chrono::steady_clock::now().time_since_epoch() + timeout;
+        delay_timer.start(timeout.count(), this);
     }
 
     template<typename Win>
@@ -182,13 +193,15 @@ public:
         QRegion repaints;
         std::deque<typename space_t::window_t> windows;
 
-        QElapsedTimer test_timer;
-        test_timer.start();
+        QElapsedTimer prepare_timer;
+        prepare_timer.start();
 
         if (!prepare_run(repaints, windows)) {
             return;
         }
 
+        telemetry.prepare.update(std::chrono::nanoseconds(prepare_timer.nsecsElapsed()));
+
         auto const ftrace_identifier = QString::fromStdString("paint-" + std::to_string(index));
 
         Perf::Ftrace::begin(ftrace_identifier, ++msc);
@@ -197,16 +210,26 @@ public:
         auto now = std::chrono::duration_cast<std::chrono::milliseconds>(now_ns);
 
         // Start the actual painting process.
-        auto const duration
-            = std::chrono::nanoseconds(platform.scene->paint_output(&base, repaints, windows, now));
+        auto const paint_duration = platform.scene->paint_output(&base, repaints, windows, now);
+
+        // Frames that were not composited, for example because a window's buffer was scanned out
+        // directly, would only skew the prediction and the telemetry.
+        if (paint_duration) {
+            auto const duration = std::chrono::nanoseconds(*paint_duration);
 
 #if SWAP_TIME_DEBUG
-        qDebug().noquote() << "RUN gap:" << to_ms(now_ns - swap_ref_time)
-                           << "paint:" << to_ms(duration);
-        swap_ref_time = now_ns;
+            qDebug().noquote() << "RUN gap:" << to_ms(now_ns - swap_ref_time)
+                               << "paint:" << to_ms(duration);
+            swap_ref_time = now_ns;
 #endif
 
-        paint_durations.update(duration);
+            paint_durations.update(duration);
+            telemetry.paint.update(duration);
+        }
+
+        if (swap_pending) {
+            telemetry.submitted(std::chrono::steady_clock::now().time_since_epoch());
+        }
         retard_next_run();
 
         if (!windows.empty()) {
@@ -227,7 +250,7 @@ public:
 
     void dry_run()
     {
-        auto windows = win::render_stack(platform.space->stacking.order);
+        auto const& windows = win::render_stack(platform.space->stacking.order);
         std::deque<typename space_t::window_t> frame_windows;
 
         for (auto win : windows) {
@@ -254,6 +277,10 @@ public:
     {
         platform.presentation->presented(this, data);
         last_presentation = data;
+
+        telemetry.presented(data.when,
+                            data.refresh > std::chrono::nanoseconds::zero() ? data.refresh
+                                                                            : refresh_length());
     }
 
     void frame()
@@ -283,31 +310,45 @@ public:
     QBasicTimer frame_timer;
     std::vector<render::gl::timer_query> last_timer_queries;
 
+    output_telemetry telemetry;
+
 private:
+    /// Collects the repaints of @p win in @p shared_repaints to forward them to other outputs.
     template<typename Win>
-    bool prepare_repaint(Win* win)
+    bool prepare_repaint(Win* win, QRegion& shared_repaints)
     {
         if (!win->has_pending_repaints()) {
             return false;
         }
 
         auto const repaints = win::repaints(*win);
-        if (repaints.intersected(base.geometry()).isEmpty()) {
+        if (!repaints.intersects(base.geometry())) {
             // TODO(romangg): Remove win from windows list?
             return false;
         }
 
+        shared_repaints += repaints;
+        return true;
+    }
+
+    /// Adds the repaints of this run's windows to all other outputs they overlap.
+    void forward_repaints(QRegion const& shared_repaints)
+    {
+        if (shared_repaints.isEmpty()) {
+            return;
+        }
+
+        auto const bounds = shared_repaints.boundingRect();
+
         for (auto& output : platform.base.outputs) {
-            if (output == &base) {
+            if (output == &base || !bounds.intersects(output->geometry())) {
                 continue;
             }
-            auto const capped_region = repaints.intersected(output->geometry());
+            auto const capped_region = shared_repaints.intersected(output->geometry());
             if (!capped_region.isEmpty()) {
                 output->render->add_repaint(capped_region);
             }
         }
-
-        return true;
     }
 
     bool prepare_run(QRegion& repaints, std::deque<typename space_t::window_t>& windows)
@@ -324,28 +365,30 @@ private:
             return false;
         }
 
-        // Create a list of all windows in the stacking order
-        windows = win::render_stack(platform.space->stacking.order);
+        // Create a list of all windows in the stacking order. The render stack is shared between
+        // outputs, we only copy the windows we keep.
+        auto const& render_stack = win::render_stack(platform.space->stacking.order);
         bool has_window_repaints{false};
+        QRegion shared_repaints;
         std::deque<typename space_t::window_t> frame_windows;
+        std::vector<typename space_t::window_t> orphaned_windows;
 
-        auto window_it = windows.begin();
-        while (window_it != windows.end()) {
+        windows.clear();
+
+        for (auto const& var_win : render_stack) {
             std::visit(overload{[&](auto&& win) {
                            if (win->remnant && win->transient->annexed) {
                                if (auto lead = win::lead_of_annexed_transient(win);
                                    !lead || !lead->remnant) {
-                                   // TODO(romangg): Add repaint to compositor?
-                                   win->remnant->refcount = 0;
-                                   win::delete_window_from_space(win->space, *win);
-                                   window_it = windows.erase(window_it);
+                                   // Deleted after the loop as it changes the render stack.
+                                   orphaned_windows.push_back(var_win);
                                    return;
                                }
                            }
 
-                           window_it++;
+                           windows.push_back(var_win);
 
-                           if (prepare_repaint(win)) {
+                           if (prepare_repaint(win, shared_repaints)) {
                                has_window_repaints = true;
                            } else {
                                if constexpr (requires(decltype(win) win) { win->surface; }) {
@@ -366,21 +409,27 @@ private:
 
                                win->render_data.is_damaged = false;
 
-                               // Discard the cached lanczos texture
-                               if (win->transient->annexed) {
-                                   win = win::lead_of_annexed_transient(win);
-                               }
-
-                               auto const texture = win->render->effect->data(LanczosCacheRole);
-                               if (texture.isValid()) {
-                                   delete static_cast<GLTexture*>(texture.template value<void*>());
-                                   win->render->effect->setData(LanczosCacheRole, QVariant());
-                               }
+                               // Outdate the cached lanczos texture
+                               auto lead = win->transient->annexed
+                                   ? win::lead_of_annexed_transient(win)
+                                   : win;
+                               gl::lanczos_cache::damage(*lead->render->effect);
                            }
                        }},
-                       *window_it);
+                       var_win);
         }
 
+        for (auto var_win : orphaned_windows) {
+            std::visit(overload{[](auto&& win) {
+                           // TODO(romangg): Add repaint to compositor?
+                           win->remnant->refcount = 0;
+                           win::delete_window_from_space(win->space, *win);
+                       }},
+                       var_win);
+        }
+
+        forward_repaints(shared_repaints);
+
         // Move elevated windows to the top of the stacking order
         auto const elevated_windows = platform.effects->elevatedWindows();
         for (auto effect_window : elevated_windows) {
@@ -456,9 +505,11 @@ private:
         return std::chrono::nanoseconds(1000 * 1000 * (1000 * 1000 / base.refresh_rate()));
     }
 
+protected:
     void timerEvent(QTimerEvent* event) override
     {
         if (event->timerId() == delay_timer.timerId()) {
+            telemetry.scheduled_run(std::chrono::steady_clock::now().time_since_epoch());
             run();
             return;
         }
@@ -469,6 +520,7 @@ private:
         QObject::timerEvent(event);
     }
 
+private:
     int index;
 
     ulong msc{0};
@@ -477,8 +529,8 @@ private:
     std::chrono::nanoseconds delay{0};
 
     presentation_data last_presentation;
-    duration_record paint_durations;
-    duration_record render_durations;
+    duration_predictor paint_durations;
+    duration_predictor render_durations;
 
     // Used for debugging rendering time.
     std::chrono::nanoseconds swap_ref_time{};
@@ -0,0 +1,100 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "duration_predictor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace como::render::wayland
+{
+
+/// Distribution of a recurring duration where older values lose weight over time.
+struct duration_telemetry {
+    void update(std::chrono::nanoseconds duration)
+    {
+        duration = std::max(duration, std::chrono::nanoseconds::zero());
+
+        count++;
+        last = duration;
+        total += duration;
+        max = std::max(max, duration);
+        histogram.update(duration);
+    }
+
+    uint64_t count{0};
+    std::chrono::nanoseconds last{0};
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds max{0};
+    duration_histogram histogram;
+};
+
+/**
+ * Frame timings of an output for monitoring frame pacing at runtime. In contrast to the duration
+ * predictors these are only collected and never influence scheduling.
+ */
+struct output_telemetry {
+    /// Called when the delay timer of the output fires.
+    void scheduled_run(std::chrono::nanoseconds now)
+    {
+        if (planned_run) {
+            schedule_delay.update(now - *planned_run);
+            planned_run.reset();
+        }
+    }
+
+    /// Called when a frame was handed to the backend at @p now.
+    void submitted(std::chrono::nanoseconds now)
+    {
+        last_submit = now;
+    }
+
+    /// Called with the presentation feedback for the last submitted frame.
+    void presented(std::chrono::nanoseconds when, std::chrono::nanoseconds refresh)
+    {
+        if (!last_submit) {
+            return;
+        }
+
+        auto const latency = when - *last_submit;
+        last_submit.reset();
+
+        presentation_latency.update(latency);
+        presented_frames++;
+
+        // A frame that is submitted right after a vblank is presented within one refresh cycle.
+        // Every further cycle it takes is a vblank the frame missed.
+        if (refresh > std::chrono::nanoseconds::zero() && latency > refresh) {
+            missed_vblanks += latency / refresh;
+        }
+    }
+
+    void reset()
+    {
+        *this = {};
+    }
+
+    /// Preparation of a run, including runs without a composited frame.
+    duration_telemetry prepare;
+    duration_telemetry paint;
+    duration_telemetry gpu;
+    duration_telemetry schedule_delay;
+    duration_telemetry presentation_latency;
+
+    uint64_t presented_frames{0};
+    uint64_t missed_vblanks{0};
+
+    /// Point in time at which the delay timer is expected to fire.
+    std::optional<std::chrono::nanoseconds> planned_run;
+
+private:
+    std::optional<std::chrono::nanoseconds> last_submit;
+};
+
+}
@@ -8,6 +8,7 @@
 #include <como/render/backend/wlroots/backend.h>
 #include <como/render/compositor.h>
 #include <como/render/dbus/compositing.h>
+#include <como/render/dbus/frame_telemetry.h>
 #include <como/render/gl/backend.h>
 #include <como/render/gl/egl_data.h>
 #include <como/render/gl/scene.h>
@@ -15,6 +16,7 @@
 #include <como/render/post/night_color_manager.h>
 #include <como/render/qpainter/scene.h>
 #include <como/render/singleton_interface.h>
+#include <como/render/wayland/hardware_cursor.h>
 #include <como/render/wayland/shadow.h>
 #include <como/render/wayland/xwl_effects.h>
 #include <como/render/x11/compositor_start.h>
@@ -54,6 +56,7 @@ public:
                 base.server->display.get());
         })}
         , dbus{std::make_unique<dbus::compositing<type>>(*this)}
+        , telemetry{std::make_unique<dbus::frame_telemetry<type>>(*this)}
     {
         singleton_interface::get_egl_data = [this] { return egl_data; };
 
@@ -163,6 +166,7 @@ public:
                              });
             QObject::connect(
                 space.qobject.get(), &win::space_qobject::destroyed, this->qobject.get(), [this] {
+                    hw_cursor.reset();
                     for (auto& output : base.outputs) {
                         output->render->delay_timer.stop();
                     }
@@ -170,11 +174,17 @@ public:
             this->space = &space;
         }
 
-        // For now we use the software cursor as our wlroots backend does not support yet a hardware
-        // cursor.
+        // The software cursor is only painted when the cursor can not be shown in the hardware
+        // cursor planes or when it is enforced through the environment.
+        hw_cursor.reset();
         using sw_cursor_t = typename decltype(this->software_cursor)::element_type;
         this->software_cursor = std::make_unique<sw_cursor_t>(*this);
-        this->software_cursor->set_enabled(true);
+
+        if (qEnvironmentVariableIsSet("KWIN_FORCE_SW_CURSOR")) {
+            this->software_cursor->set_enabled(true);
+        } else {
+            hw_cursor = std::make_unique<wayland::hardware_cursor<type>>(*this);
+        }
 
         try {
             if (compositor_prepare_scene(*this)) {
@@ -307,6 +317,7 @@ public:
     std::unique_ptr<effects_t> effects;
     std::unique_ptr<wayland::presentation> presentation;
     std::unique_ptr<cursor<type>> software_cursor;
+    std::unique_ptr<wayland::hardware_cursor<type>> hw_cursor;
 
     std::unique_ptr<x11::compositor_selection_owner> selection_owner;
 
@@ -318,6 +329,7 @@ public:
 private:
     int locked{0};
     std::unique_ptr<dbus::compositing<type>> dbus;
+    std::unique_ptr<dbus::frame_telemetry<type>> telemetry;
 };
 
 }
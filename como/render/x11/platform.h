@@ -115,6 +115,9 @@ public:
 
     virtual ~platform()
     {
+        if (auto conn = base.x11_data.connection) {
+            damage_collector.release(conn);
+        }
         delete_unused_support_properties(*this);
         selection_owner = {};
 
@@ -464,7 +467,8 @@ public:
 
         for (auto output : base.outputs) {
             // TODO(romangg): Only paint windows that intersect output.
-            duration += scene->paint_output(output, repaints & output->geometry(), windows, now);
+            duration += scene->paint_output(output, repaints & output->geometry(), windows, now)
+                            .value_or(0);
         }
 
         scene->end_paint();
@@ -606,6 +610,8 @@ private:
         std::deque<typename space_t::window_t> damaged_windows;
         auto has_pending_repaints{false};
 
+        damage_collector.start_frame();
+
         for (auto win : win::render_stack(this->space->stacking.order)) {
             std::visit(overload{[&](x11_ref_window_t* win) {
                                     // Skip windows that are not yet ready for being painted.
@@ -616,7 +622,7 @@ private:
                                     has_pending_repaints |= win->has_pending_repaints();
 
                                     // Doesn't wait for replies.
-                                    if (win::x11::damage_reset_and_fetch(*win)) {
+                                    if (win::x11::damage_reset_and_fetch(*win, damage_collector)) {
                                         damaged_windows.push_back(win);
                                     }
 
@@ -651,23 +657,14 @@ private:
             }
         }
 
-        auto discard_lanczos_texture = [](auto window) {
-            assert(window->render);
-            assert(window->render->effect);
-
-            auto const texture = window->render->effect->data(LanczosCacheRole);
-            if (texture.isValid()) {
-                delete static_cast<GLTexture*>(texture.template value<void*>());
-                window->render->effect->setData(LanczosCacheRole, QVariant());
-            }
-        };
-
-        // Get the damage region replies if there are any damaged windows, and discard the lanczos
+        // Get the damage region replies if there are any damaged windows, and outdate the lanczos
         // texture
         for (auto vwin : damaged_windows) {
             auto win = std::get<x11_ref_window_t*>(vwin);
-            discard_lanczos_texture(win);
-            win::x11::damage_fetch_region_reply(*win);
+            assert(win->render);
+            assert(win->render->effect);
+            gl::lanczos_cache::damage(*win->render->effect);
+            win::x11::damage_fetch_region_reply(*win, damage_collector.max_rects);
             if (win->has_pending_repaints()) {
                 // Add all outputs, since we paint over all in the backend.
                 win->render_data.repaint_outputs = base.outputs;
@@ -753,6 +750,8 @@ private:
     QTimer m_releaseSelectionTimer;
     int m_framesToTestForSafety{3};
 
+    win::x11::damage_collector damage_collector;
+
     std::unique_ptr<dbus::compositing<type>> dbus;
 
     // 2 sec which should be enough to restart the compositor.
@@ -10,7 +10,13 @@
 #include "geo.h"
 #include "geo_block.h"
 #include "geo_move.h"
+#include "snap_index.h"
+#include "space_qobject.h"
 #include "window_area.h"
+#include "window_qobject.h"
+
+#include <memory>
+#include <vector>
 
 namespace como::win
 {
@@ -332,6 +338,127 @@ void check_workspace_position(Win* win,
     win->setFrameGeometry(frame_geo);
 }
 
+/// Geometries of the windows that @p window snaps to when being moved, in stacking order.
+template<typename Space, typename Win>
+std::vector<QRect> get_move_snap_windows(Space const& space, Win const& window)
+{
+    std::vector<QRect> geos;
+
+    for (auto win : space.windows) {
+        std::visit(overload{[&](auto&& win) {
+                       if (!win->control) {
+                           return;
+                       }
+                       if constexpr (std::is_same_v<std::decay_t<decltype(win)>, Win*>) {
+                           if (win == &window) {
+                               return;
+                           }
+                       }
+                       if (win->control->minimized) {
+                           return;
+                       }
+                       if (!win->isShown()) {
+                           return;
+                       }
+                       if (!on_subspace(*win, get_subspace(window))
+                           && !on_subspace(window, get_subspace(*win))) {
+                           // wrong subspace
+                           return;
+                       }
+                       if (is_desktop(win) || is_splash(win) || is_applet_popup(win)) {
+                           return;
+                       }
+                       geos.push_back(win->geo.frame);
+                   }},
+                   win);
+    }
+
+    return geos;
+}
+
+/// Geometries of the windows that @p window snaps to when being resized, in stacking order.
+template<typename Space, typename Win>
+std::vector<QRect> get_resize_snap_windows(Space const& space, Win const& window)
+{
+    std::vector<QRect> geos;
+
+    for (auto win : space.windows) {
+        std::visit(overload{[&](auto&& win) {
+                       if (!win->control || !on_subspace(*win, space.subspace_manager->current)
+                           || win->control->minimized) {
+                           return;
+                       }
+                       if constexpr (std::is_same_v<std::remove_pointer_t<decltype(win)>, Win>) {
+                           if (win == &window) {
+                               return;
+                           }
+                       }
+                       geos.push_back(win->geo.frame);
+                   }},
+                   win);
+    }
+
+    return geos;
+}
+
+/**
+ * Drops the snap indexes of the move-resize operation of @p window when the windows it snaps to
+ * may have changed, such that they are built again on the next motion. This includes a change of
+ * the current subspace, for example when the window is dragged over a screen edge.
+ */
+template<typename Space, typename Win>
+void watch_snap_windows(Space const& space, Win const& window)
+{
+    auto& mov_res = window.control->move_resize;
+    mov_res.snap_notifier = std::make_unique<QObject>();
+
+    auto notifier = mov_res.snap_notifier.get();
+    auto reset = [&mov_res] {
+        mov_res.move_snap.reset();
+        mov_res.resize_snap.reset();
+    };
+
+    auto connect_space = [&](auto signal) {
+        QObject::connect(space.qobject.get(), signal, notifier, reset);
+    };
+
+    connect_space(&space_qobject::current_subspace_changed);
+    connect_space(&space_qobject::clientAdded);
+    connect_space(&space_qobject::clientRemoved);
+    connect_space(&space_qobject::wayland_window_added);
+    connect_space(&space_qobject::wayland_window_removed);
+    connect_space(&space_qobject::internalClientAdded);
+    connect_space(&space_qobject::internalClientRemoved);
+    connect_space(&space_qobject::window_deleted);
+
+    for (auto win : space.windows) {
+        std::visit(overload{[&](auto&& win) {
+                       if (!win->control) {
+                           return;
+                       }
+
+                       auto connect_win = [&](auto signal) {
+                           QObject::connect(win->qobject.get(), signal, notifier, reset);
+                       };
+
+                       connect_win(&window_qobject::subspaces_changed);
+
+                       if constexpr (std::is_same_v<std::decay_t<decltype(win)>, Win*>) {
+                           if (win == &window) {
+                               // Only the subspaces of the window itself matter.
+                               return;
+                           }
+                       }
+
+                       connect_win(&window_qobject::frame_geometry_changed);
+                       connect_win(&window_qobject::minimizedChanged);
+                       connect_win(&window_qobject::windowShown);
+                       connect_win(&window_qobject::windowHidden);
+                   }},
+                   win);
+    }
+}
+
 /**
  * Client \a c is moved around to position \a pos. This gives the
  * space:: the opportunity to interveniate and to implement
@@ -463,37 +590,11 @@ QPoint adjust_window_position(Space const& space,
         // windows snap
         int snap = space.options->qobject->windowSnapZone() * snapAdjust;
         if (snap) {
-            for (auto win : space.windows) {
-                std::visit(overload{[&](auto&& win) {
-                               if (!win->control) {
-                                   return;
-                               }
-                               if constexpr (std::is_same_v<std::decay_t<decltype(win)>, Win*>) {
-                                   if (win == &window) {
-                                       return;
-                                   }
-                               }
-                               if (win->control->minimized) {
-                                   return;
-                               }
-                               if (!win->isShown()) {
-                                   return;
-                               }
-                               if (!on_subspace(*win, get_subspace(window))
-                                   && !on_subspace(window, get_subspace(*win))) {
-                                   // wrong subspace
-                                   return;
-                               }
-                               if (is_desktop(win) || is_splash(win) || is_applet_popup(win)) {
-                                   return;
-                               }
-
-                               lx = win->geo.pos().x();
-                               ly = win->geo.pos().y();
-                               lrx = lx + win->geo.size().width();
-                               lry = ly + win->geo.size().height();
-                           }},
-                           win);
+            auto snap_to_window = [&](QRect const& geo) {
+                lx = geo.x();
+                ly = geo.y();
+                lrx = lx + geo.width();
+                lry = ly + geo.height();
 
                 if (!flags(guideMaximized & maximize_mode::horizontal)
                     && (((cy <= lry) && (cy >= ly)) || ((ry >= ly) && (ry <= lry))
@@ -553,6 +654,23 @@ QPoint adjust_window_position(Space const& space,
                         nx = lx;
                     }
                 }
+            };
+
+            if (window.control && window.control->move_resize.enabled) {
+                // All conditions compare the other window's edges with the unsnapped edges of
+                // this window, so only windows with an edge in snapping distance matter.
+                auto& index = window.control->move_resize.move_snap;
+                if (!index) {
+                    index = snap_index(get_move_snap_windows(space, window));
+                    watch_snap_windows(space, window);
+                }
+                for (auto pos : index->query({cx, rx}, {cy, ry}, snap)) {
+                    snap_to_window(index->windows().at(pos));
+                }
+            } else {
+                for (auto const& geo : get_move_snap_windows(space, window)) {
+                    snap_to_window(geo);
+                }
             }
         }
 
@@ -689,137 +807,143 @@ QRect adjust_window_size(Space const& space, Win const& window, QRect moveResize
         if (snap) {
             deltaX = int(snap);
             deltaY = int(snap);
-            for (auto win : space.windows) {
-                std::visit(
-                    overload{[&](auto&& win) {
-                        if (!win->control || !on_subspace(*win, space.subspace_manager->current)
-                            || win->control->minimized) {
-                            return;
-                        }
-                        if constexpr (std::is_same_v<std::remove_pointer_t<decltype(win)>, Win>) {
-                            if (win == &window) {
-                                return;
-                            }
-                        }
-                        lx = win->geo.pos().x() - 1;
-                        ly = win->geo.pos().y() - 1;
-                        lrx = win->geo.pos().x() + win->geo.size().width();
-                        lry = win->geo.pos().y() + win->geo.size().height();
-
-                        auto within_height = [&] {
-                            return ((newcy <= lry) && (newcy >= ly))
-                                || ((newry >= ly) && (newry <= lry))
-                                || ((newcy <= ly) && (newry >= lry));
-                        };
-                        auto within_width = [&] {
-                            return ((cx <= lrx) && (cx >= lx)) || ((rx >= lx) && (rx <= lrx))
-                                || ((cx <= lx) && (rx >= lrx));
-                        };
-
-                        auto snap_window_top = [&] {
-                            if ((sOWO ? (newcy < lry) : true) && within_width()
-                                && (qAbs(lry - newcy) < deltaY)) {
-                                deltaY = qAbs(lry - newcy);
-                                newcy = lry;
-                            }
-                        };
-                        auto snap_window_bottom = [&] {
-                            if ((sOWO ? (newry > ly) : true) && within_width()
-                                && (qAbs(ly - newry) < deltaY)) {
-                                deltaY = qAbs(ly - newry);
-                                newry = ly;
-                            }
-                        };
-                        auto snap_window_left = [&] {
-                            if ((sOWO ? (newcx < lrx) : true) && within_height()
-                                && (qAbs(lrx - newcx) < deltaX)) {
-                                deltaX = qAbs(lrx - newcx);
-                                newcx = lrx;
-                            }
-                        };
-                        auto snap_window_right = [&] {
-                            if ((sOWO ? (newrx > lx) : true) && within_height()
-                                && (qAbs(lx - newrx) < deltaX)) {
-                                deltaX = qAbs(lx - newrx);
-                                newrx = lx;
-                            }
-                        };
-                        auto snap_window_c_top = [&] {
-                            if ((sOWO ? (newcy < ly) : true) && (newcx == lrx || newrx == lx)
-                                && qAbs(ly - newcy) < deltaY) {
-                                deltaY = qAbs(ly - newcy + 1);
-                                newcy = ly + 1;
-                            }
-                        };
-                        auto snap_window_c_bottom = [&] {
-                            if ((sOWO ? (newry > lry) : true) && (newcx == lrx || newrx == lx)
-                                && qAbs(lry - newry) < deltaY) {
-                                deltaY = qAbs(lry - newry - 1);
-                                newry = lry - 1;
-                            }
-                        };
-                        auto snap_window_c_left = [&] {
-                            if ((sOWO ? (newcx < lx) : true) && (newcy == lry || newry == ly)
-                                && qAbs(lx - newcx) < deltaX) {
-                                deltaX = qAbs(lx - newcx + 1);
-                                newcx = lx + 1;
-                            }
-                        };
-                        auto snap_window_c_right = [&] {
-                            if ((sOWO ? (newrx > lrx) : true) && (newcy == lry || newry == ly)
-                                && qAbs(lrx - newrx) < deltaX) {
-                                deltaX = qAbs(lrx - newrx - 1);
-                                newrx = lrx - 1;
-                            }
-                        };
-
-                        switch (mode) {
-                        case position::bottom_right:
-                            snap_window_bottom();
-                            snap_window_right();
-                            snap_window_c_bottom();
-                            snap_window_c_right();
-                            break;
-                        case position::right:
-                            snap_window_right();
-                            snap_window_c_right();
-                            break;
-                        case position::bottom:
-                            snap_window_bottom();
-                            snap_window_c_bottom();
-                            break;
-                        case position::top_left:
-                            snap_window_top();
-                            snap_window_left();
-                            snap_window_c_top();
-                            snap_window_c_left();
-                            break;
-                        case position::left:
-                            snap_window_left();
-                            snap_window_c_left();
-                            break;
-                        case position::top:
-                            snap_window_top();
-                            snap_window_c_top();
-                            break;
-                        case position::top_right:
-                            snap_window_top();
-                            snap_window_right();
-                            snap_window_c_top();
-                            snap_window_c_right();
-                            break;
-                        case position::bottom_left:
-                            snap_window_bottom();
-                            snap_window_left();
-                            snap_window_c_bottom();
-                            snap_window_c_left();
-                            break;
-                        default:
-                            abort();
-                            break;
-                        }
-                    }},
-                    win);
+            auto snap_to_window = [&](QRect const& geo) {
+                lx = geo.x() - 1;
+                ly = geo.y() - 1;
+                lrx = geo.x() + geo.width();
+                lry = geo.y() + geo.height();
+
+                auto within_height = [&] {
+                    return ((newcy <= lry) && (newcy >= ly))
+                        || ((newry >= ly) && (newry <= lry))
+                        || ((newcy <= ly) && (newry >= lry));
+                };
+                auto within_width = [&] {
+                    return ((cx <= lrx) && (cx >= lx)) || ((rx >= lx) && (rx <= lrx))
+                        || ((cx <= lx) && (rx >= lrx));
+                };
+
+                auto snap_window_top = [&] {
+                    if ((sOWO ? (newcy < lry) : true) && within_width()
+                        && (qAbs(lry - newcy) < deltaY)) {
+                        deltaY = qAbs(lry - newcy);
+                        newcy = lry;
+                    }
+                };
+                auto snap_window_bottom = [&] {
+                    if ((sOWO ? (newry > ly) : true) && within_width()
+                        && (qAbs(ly - newry) < deltaY)) {
+                        deltaY = qAbs(ly - newry);
+                        newry = ly;
+                    }
+                };
+                auto snap_window_left = [&] {
+                    if ((sOWO ? (newcx < lrx) : true) && within_height()
+                        && (qAbs(lrx - newcx) < deltaX)) {
+                        deltaX = qAbs(lrx - newcx);
+                        newcx = lrx;
+                    }
+                };
+                auto snap_window_right = [&] {
+                    if ((sOWO ? (newrx > lx) : true) && within_height()
+                        && (qAbs(lx - newrx) < deltaX)) {
+                        deltaX = qAbs(lx - newrx);
+                        newrx = lx;
+                    }
+                };
+                auto snap_window_c_top = [&] {
+                    if ((sOWO ? (newcy < ly) : true) && (newcx == lrx || newrx == lx)
+                        && qAbs(ly - newcy) < deltaY) {
+                        deltaY = qAbs(ly - newcy + 1);
+                        newcy = ly + 1;
+                    }
+                };
+                auto snap_window_c_bottom = [&] {
+                    if ((sOWO ? (newry > lry) : true) && (newcx == lrx || newrx == lx)
+                        && qAbs(lry - newry) < deltaY) {
+                        deltaY = qAbs(lry - newry - 1);
+                        newry = lry - 1;
+                    }
+                };
+                auto snap_window_c_left = [&] {
+                    if ((sOWO ? (newcx < lx) : true) && (newcy == lry || newry == ly)
+                        && qAbs(lx - newcx) < deltaX) {
+                        deltaX = qAbs(lx - newcx + 1);
+                        newcx = lx + 1;
+                    }
+                };
+                auto snap_window_c_right = [&] {
+                    if ((sOWO ? (newrx > lrx) : true) && (newcy == lry || newry == ly)
+                        && qAbs(lrx - newrx) < deltaX) {
+                        deltaX = qAbs(lrx - newrx - 1);
+                        newrx = lrx - 1;
+                    }
+                };
+
+                switch (mode) {
+                case position::bottom_right:
+                    snap_window_bottom();
+                    snap_window_right();
+                    snap_window_c_bottom();
+                    snap_window_c_right();
+                    break;
+                case position::right:
+                    snap_window_right();
+                    snap_window_c_right();
+                    break;
+                case position::bottom:
+                    snap_window_bottom();
+                    snap_window_c_bottom();
+                    break;
+                case position::top_left:
+                    snap_window_top();
+                    snap_window_left();
+                    snap_window_c_top();
+                    snap_window_c_left();
+                    break;
+                case position::left:
+                    snap_window_left();
+                    snap_window_c_left();
+                    break;
+                case position::top:
+                    snap_window_top();
+                    snap_window_c_top();
+                    break;
+                case position::top_right:
+                    snap_window_top();
+                    snap_window_right();
+                    snap_window_c_top();
+                    snap_window_c_right();
+                    break;
+                case position::bottom_left:
+                    snap_window_bottom();
+                    snap_window_left();
+                    snap_window_c_bottom();
+                    snap_window_c_left();
+                    break;
+                default:
+                    abort();
+                    break;
+                }
+            };
+
+            auto& mov_res = window.control->move_resize;
+            if (mov_res.enabled) {
+                // Snapping moves the compared edges of this window. Chained snaps move them by
+                // less than the previous snap, which keeps the total drift below this distance.
+                if (!mov_res.resize_snap) {
+                    mov_res.resize_snap = snap_index(get_resize_snap_windows(space, window));
+                    watch_snap_windows(space, window);
+                }
+                auto const& index = *mov_res.resize_snap;
+                auto const distance = snap * (snap + 1) / 2 + 1;
+                for (auto pos : index.query({newcx, newrx}, {newcy, newry}, distance)) {
+                    snap_to_window(index.windows().at(pos));
+                }
+            } else {
+                for (auto const& geo : get_resize_snap_windows(space, window)) {
+                    snap_to_window(geo);
+                }
             }
         }
 
@@ -285,6 +285,9 @@ bool start_move_resize(Win* win)
     }
 
     mov_res.enabled = true;
+    mov_res.move_snap.reset();
+    mov_res.resize_snap.reset();
+    mov_res.snap_notifier.reset();
     set_move_resize_window(win->space, *win);
 
     win->control->update_have_resize_effect();
@@ -750,6 +753,9 @@ void finish_move_resize(Win* win, bool cancel)
 
     auto const wasResize = is_resize(win);
     mov_res.enabled = false;
+    mov_res.move_snap.reset();
+    mov_res.resize_snap.reset();
+    mov_res.snap_notifier.reset();
 
     if constexpr (requires(Win win) { win.leaveMoveResize(); }) {
         win->leaveMoveResize();
@@ -11,11 +11,14 @@
 
 #include "book_settings.h"
 #include "rules_settings.h"
+#include "ruling.h"
 
 #include <KConfig>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <algorithm>
+#include <iterator>
 
 namespace como::win::rules
 {
@@ -40,6 +43,7 @@ void book::deleteAll()
 {
     qDeleteAll(m_rules);
     m_rules.clear();
+    update_index();
 }
 
 void book::load()
@@ -55,6 +59,7 @@ void book::load()
     book_settings book(config);
     book.load();
     m_rules = book.rules();
+    update_index();
 }
 
 void book::save()
@@ -81,6 +86,57 @@ void book::requestDiskStorage()
     m_updateTimer->start();
 }
 
+std::vector<ruling*> book::candidates(QByteArray const& res_class,
+                                      QByteArray const& res_name) const
+{
+    static std::vector<size_t> const none;
+    auto lookup = [](auto const& hash, QByteArray const& key) -> std::vector<size_t> const& {
+        auto it = hash.constFind(key);
+        return it == hash.constEnd() ? none : *it;
+    };
+
+    auto const& by_class = lookup(index.by_class, res_class);
+    auto const& by_complete_class = lookup(index.by_complete_class, res_name + ' ' + res_class);
+
+    std::vector<size_t> positions;
+    positions.reserve(by_class.size() + by_complete_class.size() + index.unindexed.size());
+
+    std::merge(by_class.begin(),
+               by_class.end(),
+               by_complete_class.begin(),
+               by_complete_class.end(),
+               std::back_inserter(positions));
+
+    auto const indexed_count = positions.size();
+    positions.insert(positions.end(), index.unindexed.begin(), index.unindexed.end());
+    std::inplace_merge(positions.begin(), positions.begin() + indexed_count, positions.end());
+
+    std::vector<ruling*> ret;
+    ret.reserve(positions.size());
+    for (auto pos : positions) {
+        ret.push_back(m_rules.at(pos));
+    }
+    return ret;
+}
+
+void book::update_index()
+{
+    index.by_class.clear();
+    index.by_complete_class.clear();
+    index.unindexed.clear();
+
+    for (size_t pos = 0; pos < m_rules.size(); ++pos) {
+        auto const rule = m_rules.at(pos);
+        if (rule->wmclass.match != name_match::exact) {
+            index.unindexed.push_back(pos);
+        } else if (rule->wmclasscomplete) {
+            index.by_complete_class[rule->wmclass.data].push_back(pos);
+        } else {
+            index.by_class[rule->wmclass.data].push_back(pos);
+        }
+    }
+}
+
 void book::setUpdatesDisabled(bool disable)
 {
     m_updatesDisabled = disable;
@@ -8,8 +8,10 @@
 
 #include "window.h"
 
+#include <QHash>
 #include <QTimer>
 #include <deque>
+#include <vector>
 
 namespace como::win::rules
 {
@@ -37,6 +39,13 @@ public:
 
     void requestDiskStorage();
 
+    /// Rulings that may match a window with the given WM_CLASS, in book order.
+    std::vector<ruling*> candidates(QByteArray const& res_class,
+                                    QByteArray const& res_name) const;
+
+    /// Must be called after rulings were added to or removed from the book.
+    void update_index();
+
     std::unique_ptr<book_qobject> qobject;
     KSharedConfig::Ptr config;
     std::deque<ruling*> m_rules;
@@ -46,6 +55,15 @@ private:
 
     QTimer* m_updateTimer;
     bool m_updatesDisabled;
+
+    // Positions of rulings that match the window class exactly, keyed by the class. Depending on
+    // the ruling the class is matched alone or together with the window name. All other rulings
+    // must be tested against every window.
+    struct {
+        QHash<QByteArray, std::vector<size_t>> by_class;
+        QHash<QByteArray, std::vector<size_t>> by_complete_class;
+        std::vector<size_t> unindexed;
+    } index;
 };
 
 }
@@ -18,6 +18,7 @@ template<typename Book, typename RefWin>
 void discard_used_rules(Book& book, RefWin& ref_win, bool withdrawn)
 {
     auto updated = false;
+    auto removed = false;
 
     for (auto it = book.m_rules.begin(); it != book.m_rules.end();) {
         if (ref_win.control->rules.contains(*it)) {
@@ -29,12 +30,17 @@ void discard_used_rules(Book& book, RefWin& ref_win, bool withdrawn)
                 auto r = *it;
                 it = book.m_rules.erase(it);
                 delete r;
+                removed = true;
                 continue;
             }
         }
         ++it;
     }
 
+    if (removed) {
+        book.update_index();
+    }
+
     if (updated) {
         book.requestDiskStorage();
     }
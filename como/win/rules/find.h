@@ -38,6 +38,7 @@ void evaluate_rules(Win* win)
     }
 }
 
+/// Matches all properties of the window except its title.
 template<typename Ruling, typename RefWin>
 bool match_rule(Ruling& ruling, RefWin const& ref_win)
 {
@@ -58,36 +59,58 @@ bool match_rule(Ruling& ruling, RefWin const& ref_win)
         }
     }
 
-    if (ruling.title.match != name_match::unimportant) {
-        // Track title changes to rematch rules.
-        auto mutable_client = const_cast<RefWin*>(&ref_win);
-        QObject::connect(
-            mutable_client->qobject.get(),
-            &RefWin::qobject_t::captionChanged,
-            mutable_client->qobject.get(),
-            [mutable_client] { evaluate_rules(mutable_client); },
-            // QueuedConnection, because title may change before
-            // the client is ready (could segfault!)
-            static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection));
-    }
+    return true;
+}
+
+template<typename RefWin>
+void track_title(RefWin const& ref_win)
+{
+    auto mutable_client = const_cast<RefWin*>(&ref_win);
 
-    return ruling.matchTitle(ref_win.meta.caption.normal);
+    // Rules are only matched again when the caption itself changed and not just for example its
+    // suffix.
+    QObject::connect(
+        mutable_client->qobject.get(),
+        &RefWin::qobject_t::captionChanged,
+        mutable_client->qobject.get(),
+        [mutable_client, caption = ref_win.meta.caption.normal] {
+            if (mutable_client->meta.caption.normal != caption) {
+                evaluate_rules(mutable_client);
+            }
+        },
+        // QueuedConnection, because title may change before
+        // the client is ready (could segfault!)
+        Qt::QueuedConnection);
 }
 
 template<typename Book, typename RefWin>
 window find_window(Book& book, RefWin& ref_win)
 {
     std::vector<ruling*> ret;
+    bool title_dependent{false};
+
+    auto const candidates
+        = book.candidates(ref_win.meta.wm_class.res_class, ref_win.meta.wm_class.res_name);
+
+    for (auto rule : candidates) {
+        if (!match_rule(*rule, ref_win)) {
+            continue;
+        }
 
-    for (auto it = book.m_rules.begin(); it != book.m_rules.end();) {
-        if (match_rule(**it, ref_win)) {
-            auto rule = *it;
-            qCDebug(KWIN_CORE) << "Rule found:" << rule << ":" << &ref_win;
-            ++it;
-            ret.push_back(rule);
+        if (rule->title.match != name_match::unimportant) {
+            // Track title changes to rematch rules.
+            title_dependent = true;
+        }
+        if (!rule->matchTitle(ref_win.meta.caption.normal)) {
             continue;
         }
-        ++it;
+
+        qCDebug(KWIN_CORE) << "Rule found:" << rule << ":" << &ref_win;
+        ret.push_back(rule);
+    }
+
+    if (title_dependent) {
+        track_title(ref_win);
     }
 
     return rules::window(ret);
@@ -13,7 +13,6 @@
 #include <como/win/setup.h>
 
 #include <QFileInfo>
-#include <QRegularExpression>
 #include <kconfig.h>
 
 #include "book_settings.h"
@@ -40,17 +39,26 @@ void ruling::readFromSettings(rules::settings const* settings)
         description = settings->descriptionLegacy();
     }
 
-    auto read_bytes_match = [](auto const& data, auto const& match) {
+    auto compile_regex = [](auto& str, QString const& pattern) {
+        if (str.match == name_match::regex) {
+            str.regex.setPattern(pattern);
+            str.regex.optimize();
+        }
+    };
+
+    auto read_bytes_match = [&](auto const& data, auto const& match) {
         bytes_match bytes;
         bytes.data = data.toLatin1();
         bytes.match = static_cast<name_match>(match);
+        compile_regex(bytes, QString::fromUtf8(bytes.data));
         return bytes;
     };
 
-    auto read_string_match = [](auto const& data, auto const& match) {
+    auto read_string_match = [&](auto const& data, auto const& match) {
         string_match str;
         str.data = data;
         str.match = static_cast<name_match>(match);
+        compile_regex(str, str.data);
         return str;
     };
 
@@ -292,7 +300,6 @@ bool ruling::matchType(win_type match_type) const
 bool ruling::matchWMClass(QByteArray const& match_class, QByteArray const& match_name) const
 {
     if (wmclass.match != name_match::unimportant) {
-        // TODO optimize?
         QByteArray cwmclass;
         if (wmclasscomplete) {
             cwmclass.append(match_name);
@@ -301,9 +308,7 @@ bool ruling::matchWMClass(QByteArray const& match_class, QByteArray const& match
         cwmclass.append(match_class);
 
         if (wmclass.match == name_match::regex
-            && !QRegularExpression(QString::fromUtf8(wmclass.data))
-                    .match(QString::fromUtf8(cwmclass))
-                    .hasMatch()) {
+            && !wmclass.regex.match(QString::fromUtf8(cwmclass)).hasMatch()) {
             return false;
         }
         if (wmclass.match == name_match::exact && wmclass.data != cwmclass)
@@ -318,9 +323,7 @@ bool ruling::matchRole(QByteArray const& match_role) const
 {
     if (windowrole.match != name_match::unimportant) {
         if (windowrole.match == name_match::regex
-            && !QRegularExpression(QString::fromUtf8(windowrole.data))
-                    .match(QString::fromUtf8(match_role))
-                    .hasMatch()) {
+            && !windowrole.regex.match(QString::fromUtf8(match_role)).hasMatch()) {
             return false;
         }
         if (windowrole.match == name_match::exact && windowrole.data != match_role)
@@ -335,7 +338,7 @@ bool ruling::matchTitle(QString const& match_title) const
 {
     if (title.match != name_match::unimportant) {
         if (title.match == name_match::regex
-            && !QRegularExpression(title.data).match(match_title).hasMatch()) {
+            && !title.regex.match(match_title).hasMatch()) {
             return false;
         }
         if (title.match == name_match::exact && title.data != match_title)
@@ -353,9 +356,7 @@ bool ruling::matchClientMachine(QByteArray const& match_machine, bool local) con
         if (match_machine != "localhost" && local && matchClientMachine("localhost", true))
             return true;
         if (clientmachine.match == name_match::regex
-            && !QRegularExpression(QString::fromUtf8(clientmachine.data))
-                    .match(QString::fromUtf8(match_machine))
-                    .hasMatch()) {
+            && !clientmachine.regex.match(QString::fromUtf8(match_machine)).hasMatch()) {
             return false;
         }
         if (clientmachine.match == name_match::exact && clientmachine.data != match_machine)
@@ -9,6 +9,7 @@
 #include "types.h"
 
 #include <QRect>
+#include <QRegularExpression>
 
 #include <como/base/options.h>
 #include <como/win/subspace.h>
@@ -130,13 +131,16 @@ public:
         return checkForceStop(ruler.rule);
     }
 
+    // Regular expressions are compiled once when the ruling is read.
     struct bytes_match {
         QByteArray data;
         name_match match{name_match::unimportant};
+        QRegularExpression regex;
     };
     struct string_match {
         QString data;
         name_match match{name_match::unimportant};
+        QRegularExpression regex;
     };
 
     bytes_match wmclass;
@@ -0,0 +1,100 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <QRect>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace como::win
+{
+
+/**
+ * Sorted edges of the windows another window can snap to. It is built once when an interactive
+ * move or resize needs it, so that on every motion only windows with an edge close to the moved
+ * window are looked at.
+ */
+class snap_index
+{
+public:
+    snap_index() = default;
+
+    explicit snap_index(std::vector<QRect> windows)
+        : m_windows{std::move(windows)}
+    {
+        x_edges.reserve(2 * m_windows.size());
+        y_edges.reserve(2 * m_windows.size());
+
+        for (size_t index = 0; index < m_windows.size(); ++index) {
+            auto const& geo = m_windows.at(index);
+            x_edges.push_back({geo.x(), index});
+            x_edges.push_back({geo.x() + geo.width(), index});
+            y_edges.push_back({geo.y(), index});
+            y_edges.push_back({geo.y() + geo.height(), index});
+        }
+
+        std::sort(x_edges.begin(), x_edges.end(), edge_less);
+        std::sort(y_edges.begin(), y_edges.end(), edge_less);
+    }
+
+    /// Window geometries in the order they were provided.
+    std::vector<QRect> const& windows() const
+    {
+        return m_windows;
+    }
+
+    /**
+     * Indices of the windows with a vertical edge at most @p distance away from one of @p xs or
+     * a horizontal edge at most @p distance away from one of @p ys. Indices are ascending.
+     */
+    std::vector<size_t>
+    query(std::array<int, 2> const& xs, std::array<int, 2> const& ys, int distance) const
+    {
+        std::vector<size_t> indices;
+
+        auto collect = [&](auto const& edges, int pos) {
+            auto it = std::lower_bound(
+                edges.begin(), edges.end(), pos - distance, [](auto const& edge, int pos) {
+                    return edge.pos < pos;
+                });
+            for (; it != edges.end() && it->pos <= pos + distance; ++it) {
+                indices.push_back(it->window);
+            }
+        };
+
+        for (auto x : xs) {
+            collect(x_edges, x);
+        }
+        for (auto y : ys) {
+            collect(y_edges, y);
+        }
+
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        return indices;
+    }
+
+private:
+    struct edge {
+        int pos;
+        size_t window;
+    };
+
+    static bool edge_less(edge const& lhs, edge const& rhs)
+    {
+        return lhs.pos < rhs.pos || (lhs.pos == rhs.pos && lhs.window < rhs.window);
+    }
+
+    std::vector<QRect> m_windows;
+    std::vector<edge> x_edges;
+    std::vector<edge> y_edges;
+};
+
+}
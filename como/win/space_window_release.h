@@ -19,6 +19,7 @@ void remove_window_from_stacking_order(Space& space, Win* win)
 
     remove_all(space.stacking.order.pre_stack, var_win(win));
     remove_all(space.stacking.order.stack, var_win(win));
+    space.stacking.order.render_restack_required = true;
 }
 
 template<typename Space, typename Win>
@@ -68,6 +69,7 @@ void space_add_remnant(Win& source, Win& remnant)
     } else {
         space.stacking.order.stack.push_back(&remnant);
     }
+    space.stacking.order.render_restack_required = true;
 
     QObject::connect(remnant.qobject.get(),
                      &decltype(remnant.qobject)::element_type::needsRepaint,
@@ -16,26 +16,34 @@
 #include <algorithm>
 #include <deque>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 #include <xcb/xcb.h>
 
 namespace como::win
 {
 
+/**
+ * The windows to composite in z-direction, topmost at back. The list is shared between all callers
+ * and only rebuilt when a render restack is required, so it must not be held on to across changes
+ * of the stacking order.
+ */
 template<typename Order>
-auto render_stack(Order& order)
+auto const& render_stack(Order& order)
 {
     if (order.render_restack_required) {
         order.render_restack_required = false;
         order.render_overlays = {};
         Q_EMIT order.qobject->render_restack();
+
+        order.render_stack_cache = order.stack;
+        std::copy(std::begin(order.render_overlays),
+                  std::end(order.render_overlays),
+                  std::back_inserter(order.render_stack_cache));
     }
 
-    auto stack = order.stack;
-    std::copy(std::begin(order.render_overlays),
-              std::end(order.render_overlays),
-              std::back_inserter(stack));
-    return stack;
+    return order.render_stack_cache;
 }
 
 class COMO_EXPORT stacking_order_qobject : public QObject
@@ -126,9 +134,106 @@ public:
     std::deque<Window> render_overlays;
     std::deque<xcb_window_t> manual_overlays;
 
+    /// Must be set when the stack is changed directly, so the render stack is rebuilt.
     bool render_restack_required{false};
+    std::deque<Window> render_stack_cache;
 
 private:
+    /**
+     * List with constant time removal of arbitrary elements. Removed elements leave holes behind
+     * that are skipped when the list is taken.
+     */
+    class sort_list
+    {
+    public:
+        void push_back(Window const& win)
+        {
+            index.insert({win, items.size()});
+            items.push_back(win);
+        }
+
+        void append(sort_list const& other)
+        {
+            for (auto const& item : other.items) {
+                if (item) {
+                    push_back(*item);
+                }
+            }
+        }
+
+        void remove_all(Window const& win)
+        {
+            auto [begin, end] = index.equal_range(win);
+            for (auto it = begin; it != end; it++) {
+                items[it->second].reset();
+            }
+            index.erase(begin, end);
+        }
+
+        bool contains(Window const& win) const
+        {
+            return index.contains(win);
+        }
+
+        std::deque<Window> take() const
+        {
+            std::deque<Window> list;
+            for (auto const& item : items) {
+                if (item) {
+                    list.push_back(*item);
+                }
+            }
+            return list;
+        }
+
+    private:
+        std::vector<std::optional<Window>> items;
+        std::unordered_multimap<Window, size_t> index;
+    };
+
+    /// Positions in the current stack used to sort transient children while sorting.
+    using stack_positions = std::unordered_map<Window, size_t>;
+
+    static stack_positions get_stack_positions(std::deque<Window> const& stack)
+    {
+        stack_positions positions;
+        positions.reserve(stack.size());
+
+        // With duplicates the topmost position counts.
+        for (size_t index = 0; index < stack.size(); index++) {
+            positions[stack[index]] = index;
+        }
+        return positions;
+    }
+
+    /// Same order as ensure_stacking_order_in_list but with precomputed positions.
+    template<typename Win>
+    static std::vector<Win*> sort_by_stack_positions(stack_positions const& positions,
+                                                     std::vector<Win*> const& list)
+    {
+        using entry = std::pair<std::optional<size_t>, Win*>;
+        std::vector<entry> entries;
+        entries.reserve(list.size());
+
+        for (auto win : list) {
+            auto it = positions.find(Window(win));
+            entries.push_back(
+                {it == positions.end() ? std::nullopt : std::make_optional(it->second), win});
+        }
+
+        // Windows not in the stack stay in front in their original order.
+        std::stable_sort(entries.begin(), entries.end(), [](auto const& lhs, auto const& rhs) {
+            return lhs.first < rhs.first;
+        });
+
+        std::vector<Win*> sorted;
+        sorted.reserve(entries.size());
+        for (auto const& [pos, win] : entries) {
+            sorted.push_back(win);
+        }
+        return sorted;
+    }
+
     template<typename Win>
     static bool needs_child_restack(Win const* lead, Win const* child)
     {
@@ -143,8 +248,76 @@ private:
         return keep_transient_above(lead, child);
     }
 
+    template<typename Win>
+    static void append_children(stack_positions const& positions, Win* window, sort_list& list)
+    {
+        auto const& children = window->transient->children;
+        if (children.empty()) {
+            return;
+        }
+
+        sort_list stacked;
+
+        // Append children by one first-level child after the other but between them any
+        // transient children of each first-level child (acts recursively).
+        for (auto child : sort_by_stack_positions(positions, children)) {
+            // Transients to multiple leads are pushed to the very end.
+            if (!needs_child_restack(window, child)) {
+                continue;
+            }
+            list.remove_all(child);
+
+            stacked.push_back(child);
+            append_children(positions, child, stacked);
+        }
+
+        list.append(stacked);
+    }
+
+    template<typename Win>
+    static bool is_restacked_child(Win* win)
+    {
+        auto const leads = win->transient->leads();
+        return std::any_of(leads.cbegin(), leads.cend(), [win](auto lead) {
+            return needs_child_restack(lead, win);
+        });
+    }
+
+    bool sort()
+    {
+        auto const positions = get_stack_positions(this->stack);
+        sort_list list;
+
+        for (auto const& window : sort_windows_by_layer(pre_stack)) {
+            std::visit(overload{[&](auto&& win) {
+                           if (is_restacked_child(win)) {
+                               // Transient children that must be pushed above at least one of its
+                               // leads are inserted with append_children.
+                               return;
+                           }
+
+                           assert(!list.contains(Window(win)));
+                           list.push_back(win);
+                           append_children(positions, win, list);
+                       }},
+                       window);
+        }
+
+        auto stack = list.take();
+
+#ifndef NDEBUG
+        assert(stack == sort_reference());
+#endif
+
+        auto order_changed = this->stack != stack;
+        this->stack = std::move(stack);
+        return order_changed;
+    }
+
+#ifndef NDEBUG
     template<typename Win, typename WinWrap>
-    static void append_children(stacking_order& order, Win* window, std::deque<WinWrap>& list)
+    static void
+    append_children_reference(stacking_order& order, Win* window, std::deque<WinWrap>& list)
     {
         auto const children = window->transient->children;
         if (children.empty()) {
@@ -154,51 +327,39 @@ private:
         auto stacked_next = ensure_stacking_order_in_list(order, children);
         std::deque<WinWrap> stacked;
 
-        // Append children by one first-level child after the other but between them any
-        // transient children of each first-level child (acts recursively).
         for (auto child : stacked_next) {
-            // Transients to multiple leads are pushed to the very end.
             if (!needs_child_restack(window, child)) {
                 continue;
             }
             remove_all(list, WinWrap(child));
 
             stacked.push_back(child);
-            append_children(order, child, stacked);
+            append_children_reference(order, child, stacked);
         }
 
         list.insert(list.end(), stacked.begin(), stacked.end());
     }
 
-    bool sort()
+    /// Full sort without precomputed positions to verify the result of sort() in debug builds.
+    std::deque<Window> sort_reference()
     {
         auto pre_order = sort_windows_by_layer(pre_stack);
         std::deque<Window> stack;
 
         for (auto const& window : pre_order) {
-            std::visit(
-                overload{[this, &stack](auto&& win) {
-                    if (auto const leads = win->transient->leads();
-                        std::find_if(leads.cbegin(),
-                                     leads.cend(),
-                                     [win](auto lead) { return needs_child_restack(lead, win); })
-                        != leads.cend()) {
-                        // Transient children that must be pushed above at least one of its
-                        // leads are inserted with append_children.
-                        return;
-                    }
-
-                    assert(!contains(stack, Window(win)));
-                    stack.push_back(win);
-                    append_children(*this, win, stack);
-                }},
-                window);
+            std::visit(overload{[this, &stack](auto&& win) {
+                           if (is_restacked_child(win)) {
+                               return;
+                           }
+                           stack.push_back(win);
+                           append_children_reference(*this, win, stack);
+                       }},
+                       window);
         }
 
-        auto order_changed = this->stack != stack;
-        this->stack = stack;
-        return order_changed;
+        return stack;
     }
+#endif
 
     void process_change()
     {
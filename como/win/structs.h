@@ -8,6 +8,7 @@
 #include "cursor_shape.h"
 #include "deco/client_impl_qobject.h"
 #include "deco/palette.h"
+#include "snap_index.h"
 #include "types.h"
 
 #include <KDecoration2/Decoration>
@@ -18,6 +19,7 @@
 #include <QTimer>
 
 #include <memory>
+#include <optional>
 
 namespace como
 {
@@ -45,6 +47,12 @@ struct move_resize_op {
     cursor_shape cursor{Qt::ArrowCursor};
     int start_screen{0};
     QTimer* delay_timer{nullptr};
+
+    // Windows to snap to. Built on first use during the operation and dropped again when the
+    // windows change. Connections to these changes are owned by the notifier.
+    std::optional<snap_index> move_snap;
+    std::optional<snap_index> resize_snap;
+    std::unique_ptr<QObject> snap_notifier;
 };
 
 template<typename RefWin, typename VarWin>
@@ -179,24 +179,13 @@ inline bool wants_sync_counter(base::operation_mode mode, base::x11::data const&
     return xwayland_version > 12099000;
 }
 
+/**
+ * Sets up the sync request counter from the _NET_WM_SYNC_REQUEST_COUNTER property @p prop.
+ */
 template<typename Win>
-void get_sync_counter(Win* win)
+void read_sync_counter(Win* win, base::x11::xcb::property& prop)
 {
-    if (!base::x11::xcb::extensions::self()->is_sync_available()) {
-        return;
-    }
-    if (!wants_sync_counter(win->space.base.operation_mode, win->space.base.x11_data)) {
-        return;
-    }
-
-    base::x11::xcb::property syncProp(win->space.base.x11_data.connection,
-                                      false,
-                                      win->xcb_windows.client,
-                                      win->space.atoms->net_wm_sync_request_counter,
-                                      XCB_ATOM_CARDINAL,
-                                      0,
-                                      1);
-    auto const counter = syncProp.value<xcb_sync_counter_t>(XCB_NONE);
+    auto const counter = prop.value<xcb_sync_counter_t>(XCB_NONE);
 
     if (counter == XCB_NONE) {
         // Window without support for _NET_WM_SYNC_REQUEST.
@@ -240,6 +229,26 @@ void get_sync_counter(Win* win)
     win->sync_request.alarm = alarm_id;
 }
 
+template<typename Win>
+void get_sync_counter(Win* win)
+{
+    if (!base::x11::xcb::extensions::self()->is_sync_available()) {
+        return;
+    }
+    if (!wants_sync_counter(win->space.base.operation_mode, win->space.base.x11_data)) {
+        return;
+    }
+
+    base::x11::xcb::property syncProp(win->space.base.x11_data.connection,
+                                      false,
+                                      win->xcb_windows.client,
+                                      win->space.atoms->net_wm_sync_request_counter,
+                                      XCB_ATOM_CARDINAL,
+                                      0,
+                                      1);
+    read_sync_counter(win, syncProp);
+}
+
 /**
  * Sends the client a _NET_SYNC_REQUEST.
  */
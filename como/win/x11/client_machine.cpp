@@ -165,12 +165,25 @@ void client_machine::resolve(base::x11::data const& x11_data,
     if (m_resolved) {
         return;
     }
-    QByteArray name = net::win_info(x11_data.connection,
-                                    window,
-                                    x11_data.root_window,
-                                    net::Properties(),
-                                    net::WM2ClientMachine)
-                          .clientMachine();
+    resolve(x11_data,
+            window,
+            clientLeader,
+            net::win_info(x11_data.connection,
+                          window,
+                          x11_data.root_window,
+                          net::Properties(),
+                          net::WM2ClientMachine)
+                .clientMachine());
+}
+
+void client_machine::resolve(base::x11::data const& x11_data,
+                             xcb_window_t window,
+                             xcb_window_t clientLeader,
+                             QByteArray name)
+{
+    if (m_resolved) {
+        return;
+    }
     if (name.isEmpty() && clientLeader && clientLeader != window) {
         name = net::win_info(x11_data.connection,
                              clientLeader,
@@ -56,6 +56,11 @@ class COMO_EXPORT client_machine : public QObject
     Q_OBJECT
 public:
     void resolve(base::x11::data const& x11_data, xcb_window_t window, xcb_window_t clientLeader);
+    /// Same as above but with the WM_CLIENT_MACHINE property @p name of @p window already read.
+    void resolve(base::x11::data const& x11_data,
+                 xcb_window_t window,
+                 xcb_window_t clientLeader,
+                 QByteArray name);
     QByteArray const& hostname() const;
     bool is_local() const;
     static QByteArray localhost();
@@ -17,6 +17,7 @@
 #include "user_time.h"
 #include "win_info.h"
 #include "window_create.h"
+#include "window_prefetch.h"
 #include "xcb.h"
 
 #include <como/base/logging.h>
@@ -42,7 +43,8 @@ void embed_client(Win* win, xcb_visualid_t visualid, xcb_colormap_t colormap, ui
     // We don't want the window to be destroyed when we quit
     xcb_change_save_set(conn, XCB_SET_MODE_INSERT, win->xcb_windows.client);
 
-    win->xcb_windows.client.select_input(zero_value);
+    // Only keep property changes selected, the properties were already fetched.
+    win->xcb_windows.client.select_input(XCB_EVENT_MASK_PROPERTY_CHANGE);
     win->xcb_windows.client.unmap();
     win->xcb_windows.client.set_border_width(zero_value);
 
@@ -643,8 +645,25 @@ auto create_controlled_window(xcb_window_t xcb_win, bool isMapped, Space& space)
 
     blocker block(space.stacking.order);
 
-    base::x11::xcb::window_attributes attr(space.base.x11_data.connection, xcb_win);
-    base::x11::xcb::geometry windowGeometry(space.base.x11_data.connection, xcb_win);
+    net::Properties const properties = net::WMDesktop | net::WMState | net::WMWindowType
+        | net::WMStrut | net::WMName | net::WMIconGeometry | net::WMIcon | net::WMPid
+        | net::WMIconName;
+    net::Properties2 const properties2 = net::WM2BlockCompositing | net::WM2WindowClass
+        | net::WM2WindowRole | net::WM2UserTime | net::WM2ExtendedStrut | net::WM2Opacity
+        | net::WM2FullscreenMonitors | net::WM2GroupLeader | net::WM2Urgency | net::WM2Input
+        | net::WM2Protocols | net::WM2InitialMappingState | net::WM2IconPixmap
+        | net::WM2OpaqueRegion | net::WM2DesktopFileName | net::WM2GTKFrameExtents
+        | net::WM2GTKApplicationId | net::WM2ClientMachine;
+
+    // Everything read from the window below is requested at once here. Property changes are
+    // selected first so that no change after the fetch is missed.
+    uint32_t const property_change_mask = XCB_EVENT_MASK_PROPERTY_CHANGE;
+    xcb_change_window_attributes(
+        space.base.x11_data.connection, xcb_win, XCB_CW_EVENT_MASK, &property_change_mask);
+    window_prefetch prefetch(space, xcb_win, properties, properties2);
+
+    auto& attr = prefetch.attributes;
+    auto& windowGeometry = prefetch.geometry;
     if (attr.is_null() || windowGeometry.is_null()) {
         return nullptr;
     }
@@ -725,29 +744,11 @@ auto create_controlled_window(xcb_window_t xcb_win, bool isMapped, Space& space)
     win->xcb_visual = attr->visual;
     win->render_data.bit_depth = windowGeometry->depth;
 
-    const net::Properties properties = net::WMDesktop | net::WMState | net::WMWindowType
-        | net::WMStrut | net::WMName | net::WMIconGeometry | net::WMIcon | net::WMPid
-        | net::WMIconName;
-    const net::Properties2 properties2 = net::WM2BlockCompositing | net::WM2WindowClass
-        | net::WM2WindowRole | net::WM2UserTime | net::WM2ExtendedStrut | net::WM2Opacity
-        | net::WM2FullscreenMonitors | net::WM2GroupLeader | net::WM2Urgency | net::WM2Input
-        | net::WM2Protocols | net::WM2InitialMappingState | net::WM2IconPixmap
-        | net::WM2OpaqueRegion | net::WM2DesktopFileName | net::WM2GTKFrameExtents
-        | net::WM2GTKApplicationId;
-
-    auto wmClientLeaderCookie = fetch_wm_client_leader(*win);
-    auto skipCloseAnimationCookie = fetch_skip_close_animation(*win);
-    auto showOnScreenEdgeCookie = fetch_show_on_screen_edge(win);
-    auto transientCookie = fetch_transient(win);
-
     win->geometry_hints.init(win->xcb_windows.client);
     win->motif_hints.init(win->xcb_windows.client);
 
-    win->net_info = new win_info<Win>(win,
-                                      win->xcb_windows.client,
-                                      win->space.base.x11_data.root_window,
-                                      properties,
-                                      properties2);
+    win->net_info = new win_info<Win>(
+        win, win->space.base.x11_data.root_window, std::move(prefetch.info));
 
     if (is_desktop(win) && win->render_data.bit_depth == 32) {
         // force desktop windows to be opaque. It's a desktop after all, there is no window
@@ -757,9 +758,12 @@ auto create_controlled_window(xcb_window_t xcb_win, bool isMapped, Space& space)
     win->colormap = attr->colormap;
 
     fetch_wm_class(*win);
-    read_wm_client_leader(*win, wmClientLeaderCookie);
-    fetch_wm_client_machine(*win);
-    get_sync_counter(win);
+    read_wm_client_leader(*win, prefetch.wm_client_leader);
+    win->client_machine->resolve(win->space.base.x11_data,
+                                 win->xcb_windows.client,
+                                 get_wm_client_leader(*win),
+                                 win->net_info->clientMachine());
+    read_sync_counter(win, prefetch.sync_counter);
 
     // First only read the caption text, so that win::setup_rules(..) can use it for matching,
     // and only then really set the caption using setCaption(), which checks for duplicates etc.
@@ -778,7 +782,7 @@ auto create_controlled_window(xcb_window_t xcb_win, bool isMapped, Space& space)
         xcb_shape_select_input(space.base.x11_data.connection, win->xcb_windows.client, true);
     }
 
-    detect_shape(*win);
+    set_shape(*win, prefetch.is_shape());
     detect_no_border(win);
     fetch_iconic_name(win);
 
@@ -788,7 +792,7 @@ auto create_controlled_window(xcb_window_t xcb_win, bool isMapped, Space& space)
     update_allowed_actions(win);
 
     win->transient->set_modal((win->net_info->state() & net::Modal) != 0);
-    read_transient_property(win, transientCookie);
+    read_transient_property(win, prefetch.transient);
 
     QByteArray desktopFileName{win->net_info->desktopFileName()};
     if (desktopFileName.isEmpty()) {
@@ -805,7 +809,7 @@ auto create_controlled_window(xcb_window_t xcb_win, bool isMapped, Space& space)
     win->geometry_hints.read();
     get_motif_hints(win, true);
     fetch_wm_opaque_region(*win);
-    set_skip_close_animation(*win, skipCloseAnimationCookie.to_bool());
+    set_skip_close_animation(*win, prefetch.skip_close_animation.to_bool());
 
     // TODO: Try to obey all state information from net_info->state()
 
@@ -850,7 +854,7 @@ auto create_controlled_window(xcb_window_t xcb_win, bool isMapped, Space& space)
     win->updateWindowRules(rules::type::all);
 
     win->setBlockingCompositing(win->net_info->isBlockingCompositing());
-    read_show_on_screen_edge(win, showOnScreenEdgeCookie);
+    read_show_on_screen_edge(win, prefetch.show_on_screen_edge);
 
     // Forward all opacity values to the frame in case there'll be other CM running.
     auto comp_qobject = win->space.base.mod.render->qobject.get();
@@ -7,6 +7,9 @@
 
 #include <como/win/damage.h>
 
+#include <QVector>
+#include <algorithm>
+#include <vector>
 #include <xcb/damage.h>
 #include <xcb/xfixes.h>
 
@@ -19,6 +22,54 @@ struct damage {
     xcb_xfixes_fetch_region_cookie_t region_cookie;
 };
 
+/**
+ * Provides the XFixes regions the damage of windows is fetched through in a frame. The regions
+ * are created once and reused in later frames instead of being created and destroyed per window.
+ *
+ * All damage requests of a frame are sent before the first reply is waited on, so the fetches
+ * for all windows are pipelined in a single round trip.
+ */
+struct damage_collector {
+    damage_collector()
+    {
+        if (qEnvironmentVariableIsSet("KWIN_X11_DAMAGE_MAX_RECTS")) {
+            max_rects = std::max(1, qEnvironmentVariableIntValue("KWIN_X11_DAMAGE_MAX_RECTS"));
+        }
+    }
+
+    /// Must be called before the damage of a new frame is fetched.
+    void start_frame()
+    {
+        used_regions = 0;
+    }
+
+    xcb_xfixes_region_t acquire_region(xcb_connection_t* conn)
+    {
+        if (used_regions == regions.size()) {
+            auto region = xcb_generate_id(conn);
+            xcb_xfixes_create_region(conn, region, 0, nullptr);
+            regions.push_back(region);
+        }
+        return regions[used_regions++];
+    }
+
+    void release(xcb_connection_t* conn)
+    {
+        for (auto region : regions) {
+            xcb_xfixes_destroy_region(conn, region);
+        }
+        regions.clear();
+        used_regions = 0;
+    }
+
+    /// Damage with more rectangles than this is reduced to its bounding rectangle.
+    int max_rects{64};
+
+private:
+    std::vector<xcb_xfixes_region_t> regions;
+    size_t used_regions{0};
+};
+
 template<typename Win>
 void damage_handle_notify_event(Win& win)
 {
@@ -47,14 +98,14 @@ void damage_handle_notify_event(Win& win)
 }
 
 /**
- * Resets the damage state and sends a request for the damage region.
- * A call to this function must be followed by a call to getDamageRegionReply(),
- * or the reply will be leaked.
+ * Resets the damage state and sends a request for the damage region through a region of
+ * @p collector. A call to this function must be followed by a call to
+ * damage_fetch_region_reply(), or the reply will be leaked.
  *
  * Returns true if the window was damaged, and false otherwise.
  */
 template<typename Win>
-bool damage_reset_and_fetch(Win& win)
+bool damage_reset_and_fetch(Win& win, damage_collector& collector)
 {
     if (!win.render_data.is_damaged) {
         return false;
@@ -64,15 +115,13 @@ bool damage_reset_and_fetch(Win& win)
 
     auto conn = win.space.base.x11_data.connection;
 
-    // Create a new region and copy the damage region to it,
-    // resetting the damaged state.
-    xcb_xfixes_region_t region = xcb_generate_id(conn);
-    xcb_xfixes_create_region(conn, region, 0, nullptr);
+    // Copy the damage region to a region of the collector, resetting the damaged state. The
+    // subtract request replaces the previous content of the region.
+    auto region = collector.acquire_region(conn);
     xcb_damage_subtract(conn, win.damage.handle, 0, region);
 
-    // Send a fetch-region request and destroy the region
+    // Send a fetch-region request. The region is reused only after the reply has been received.
     win.damage.region_cookie = xcb_xfixes_fetch_region_unchecked(conn, region);
-    xcb_xfixes_destroy_region(conn, region);
 
     win.render_data.is_damaged = false;
     win.damage.is_reply_pending = true;
@@ -81,12 +130,12 @@ bool damage_reset_and_fetch(Win& win)
 }
 
 /**
- * Gets the reply from a previous call to resetAndFetchDamage().
+ * Gets the reply from a previous call to damage_reset_and_fetch().
  * Calling this function is a no-op if there is no pending reply.
- * Call damage() to return the fetched region.
+ * Damage with more than @p max_rects rectangles is reduced to its bounding rectangle.
  */
 template<typename Win>
-void damage_fetch_region_reply(Win& win)
+void damage_fetch_region_reply(Win& win, int max_rects)
 {
     if (!win.damage.is_reply_pending) {
         return;
@@ -105,7 +154,7 @@ void damage_fetch_region_reply(Win& win)
     auto count = xcb_xfixes_fetch_region_rectangles_length(reply);
     QRegion region;
 
-    if (count > 1 && count < 16) {
+    if (count > 1 && count <= max_rects) {
         auto rects = xcb_xfixes_fetch_region_rectangles(reply);
 
         QVector<QRect> qrects;
@@ -1490,13 +1490,19 @@ void set_frame_geometry(Win& win, QRect const& rect)
 }
 
 template<typename Win>
-void detect_shape(Win& win)
+void set_shape(Win& win, bool is_shape)
 {
     auto const was_shape = win.is_shape;
-    win.is_shape = base::x11::xcb::extensions::self()->has_shape(win.xcb_windows.client);
+    win.is_shape = is_shape;
     if (was_shape != win.is_shape) {
         Q_EMIT win.qobject->shapedChanged();
     }
 }
 
+template<typename Win>
+void detect_shape(Win& win)
+{
+    set_shape(win, base::x11::xcb::extensions::self()->has_shape(win.xcb_windows.client));
+}
+
 }
@@ -207,12 +207,328 @@ static void readIcon(xcb_connection_t* c,
 
 const int win_info::OnAllDesktops = net::OnAllDesktops;
 
+static std::vector<xcb_get_property_cookie_t>
+request_properties(xcb_connection_t* conn,
+                   xcb_window_t window,
+                   QSharedDataPointer<Atoms> const& atoms,
+                   net::Properties dirty,
+                   net::Properties2 dirty2)
+{
+    auto atom = [&atoms](KwsAtom kws_atom) { return atoms->atom(kws_atom); };
+
+    std::vector<xcb_get_property_cookie_t> cookies;
+    cookies.reserve(64);
+
+    if (dirty & XAWMState) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(WM_STATE), atom(WM_STATE), 0, 1));
+    }
+
+    if (dirty & WMState) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_STATE), XCB_ATOM_ATOM, 0, 2048));
+    }
+
+    if (dirty & WMDesktop) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_DESKTOP), XCB_ATOM_CARDINAL, 0, 1));
+    }
+
+    if (dirty & WMName) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_NET_WM_NAME),
+                                           atom(UTF8_STRING),
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty & WMVisibleName) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_NET_WM_VISIBLE_NAME),
+                                           atom(UTF8_STRING),
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty & WMIconName) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_NET_WM_ICON_NAME),
+                                           atom(UTF8_STRING),
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty & WMVisibleIconName) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_NET_WM_VISIBLE_ICON_NAME),
+                                           atom(UTF8_STRING),
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty & WMWindowType) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_WINDOW_TYPE), XCB_ATOM_ATOM, 0, 2048));
+    }
+
+    if (dirty & WMStrut) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_STRUT), XCB_ATOM_CARDINAL, 0, 4));
+    }
+
+    if (dirty2 & WM2ExtendedStrut) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_STRUT_PARTIAL), XCB_ATOM_CARDINAL, 0, 12));
+    }
+
+    if (dirty2 & WM2FullscreenMonitors) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_NET_WM_FULLSCREEN_MONITORS),
+                                           XCB_ATOM_CARDINAL,
+                                           0,
+                                           4));
+    }
+
+    if (dirty & WMIconGeometry) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_ICON_GEOMETRY), XCB_ATOM_CARDINAL, 0, 4));
+    }
+
+    if (dirty & WMIcon) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_ICON), XCB_ATOM_CARDINAL, 0, 0xffffffff));
+    }
+
+    if (dirty & WMFrameExtents) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_FRAME_EXTENTS), XCB_ATOM_CARDINAL, 0, 4));
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_KDE_NET_WM_FRAME_STRUT), XCB_ATOM_CARDINAL, 0, 4));
+    }
+
+    if (dirty2 & WM2FrameOverlap) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_FRAME_OVERLAP), XCB_ATOM_CARDINAL, 0, 4));
+    }
+
+    if (dirty2 & WM2Activities) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_KDE_NET_WM_ACTIVITIES),
+                                           XCB_ATOM_STRING,
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty2 & WM2BlockCompositing) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_KDE_NET_WM_BLOCK_COMPOSITING),
+                                           XCB_ATOM_CARDINAL,
+                                           0,
+                                           1));
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_BYPASS_COMPOSITOR), XCB_ATOM_CARDINAL, 0, 1));
+    }
+
+    if (dirty & WMPid) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_PID), XCB_ATOM_CARDINAL, 0, 1));
+    }
+
+    if (dirty2 & WM2StartupId) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_NET_STARTUP_ID),
+                                           atom(UTF8_STRING),
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty2 & WM2Opacity) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_WINDOW_OPACITY), XCB_ATOM_CARDINAL, 0, 1));
+    }
+
+    if (dirty2 & WM2AllowedActions) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_ALLOWED_ACTIONS), XCB_ATOM_ATOM, 0, 2048));
+    }
+
+    if (dirty2 & WM2UserTime) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_NET_WM_USER_TIME), XCB_ATOM_CARDINAL, 0, 1));
+    }
+
+    if (dirty2 & WM2TransientFor) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, XCB_ATOM_WM_TRANSIENT_FOR, XCB_ATOM_WINDOW, 0, 1));
+    }
+
+    if (dirty2
+        & (WM2GroupLeader | WM2Urgency | WM2Input | WM2InitialMappingState | WM2IconPixmap)) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, XCB_ATOM_WM_HINTS, XCB_ATOM_WM_HINTS, 0, 9));
+    }
+
+    if (dirty2 & WM2WindowClass) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, XCB_ATOM_WM_CLASS, XCB_ATOM_STRING, 0, MAX_PROP_SIZE));
+    }
+
+    if (dirty2 & WM2WindowRole) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(WM_WINDOW_ROLE), XCB_ATOM_STRING, 0, MAX_PROP_SIZE));
+    }
+
+    if (dirty2 & WM2ClientMachine) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           XCB_ATOM_WM_CLIENT_MACHINE,
+                                           XCB_ATOM_STRING,
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty2 & WM2Protocols) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(WM_PROTOCOLS), XCB_ATOM_ATOM, 0, 2048));
+    }
+
+    if (dirty2 & WM2OpaqueRegion) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_NET_WM_OPAQUE_REGION),
+                                           XCB_ATOM_CARDINAL,
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty2 & WM2DesktopFileName) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_KDE_NET_WM_DESKTOP_FILE),
+                                           atom(UTF8_STRING),
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty2 & WM2GTKApplicationId) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_GTK_APPLICATION_ID),
+                                           atom(UTF8_STRING),
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty2 & WM2GTKFrameExtents) {
+        cookies.push_back(xcb_get_property(
+            conn, false, window, atom(_GTK_FRAME_EXTENTS), XCB_ATOM_CARDINAL, 0, 4));
+    }
+
+    if (dirty2 & WM2AppMenuObjectPath) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_KDE_NET_WM_APPMENU_OBJECT_PATH),
+                                           XCB_ATOM_STRING,
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    if (dirty2 & WM2AppMenuServiceName) {
+        cookies.push_back(xcb_get_property(conn,
+                                           false,
+                                           window,
+                                           atom(_KDE_NET_WM_APPMENU_SERVICE_NAME),
+                                           XCB_ATOM_STRING,
+                                           0,
+                                           MAX_PROP_SIZE));
+    }
+
+    return cookies;
+}
+
+win_info_prefetch::win_info_prefetch(xcb_connection_t* connection,
+                                     xcb_window_t window,
+                                     net::Properties properties,
+                                     net::Properties2 properties2)
+    : connection{connection}
+    , window{window}
+    , properties{properties}
+    , properties2{properties2}
+    , cookies{request_properties(
+          connection, window, atomsForConnection(connection), properties, properties2)}
+{
+}
+
+win_info_prefetch::win_info_prefetch(win_info_prefetch&& other) noexcept
+    : connection{other.connection}
+    , window{other.window}
+    , properties{other.properties}
+    , properties2{other.properties2}
+    , cookies{std::move(other.cookies)}
+{
+    other.cookies.clear();
+}
+
+win_info_prefetch::~win_info_prefetch()
+{
+    // Replies not taken by a win_info.
+    for (auto const& cookie : cookies) {
+        xcb_discard_reply(connection, cookie.sequence);
+    }
+}
+
 win_info::win_info(xcb_connection_t* connection,
                    xcb_window_t window,
                    xcb_window_t rootWindow,
                    net::Properties properties,
                    net::Properties2 properties2,
                    Role role)
+{
+    init(connection, window, rootWindow, properties, properties2, role);
+    update(p->properties, p->properties2);
+}
+
+win_info::win_info(xcb_window_t rootWindow, win_info_prefetch&& prefetch, Role role)
+{
+    init(prefetch.connection,
+         prefetch.window,
+         rootWindow,
+         prefetch.properties,
+         prefetch.properties2,
+         role);
+
+    auto const cookies = std::move(prefetch.cookies);
+    prefetch.cookies.clear();
+    read_properties(p->properties, p->properties2, cookies);
+}
+
+void win_info::init(xcb_connection_t* connection,
+                    xcb_window_t window,
+                    xcb_window_t rootWindow,
+                    net::Properties properties,
+                    net::Properties2 properties2,
+                    Role role)
 {
     p = new win_info_private;
     p->ref = 1;
@@ -265,8 +581,6 @@ win_info::win_info(xcb_connection_t* connection,
     p->icon_count = 0;
 
     p->role = role;
-
-    update(p->properties, p->properties2);
 }
 
 win_info::win_info(const win_info& wininfo)
@@ -1567,255 +1881,15 @@ void win_info::update(net::Properties dirtyProperties, net::Properties2 dirtyPro
         dirty |= XAWMState;
     }
 
-    xcb_get_property_cookie_t cookies[255];
-    int c = 0;
-
-    if (dirty & XAWMState) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(WM_STATE), p->atom(WM_STATE), 0, 1);
-    }
-
-    if (dirty & WMState) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_STATE), XCB_ATOM_ATOM, 0, 2048);
-    }
-
-    if (dirty & WMDesktop) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_DESKTOP), XCB_ATOM_CARDINAL, 0, 1);
-    }
-
-    if (dirty & WMName) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_NET_WM_NAME),
-                                        p->atom(UTF8_STRING),
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty & WMVisibleName) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_NET_WM_VISIBLE_NAME),
-                                        p->atom(UTF8_STRING),
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty & WMIconName) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_NET_WM_ICON_NAME),
-                                        p->atom(UTF8_STRING),
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty & WMVisibleIconName) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_NET_WM_VISIBLE_ICON_NAME),
-                                        p->atom(UTF8_STRING),
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty & WMWindowType) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_WINDOW_TYPE), XCB_ATOM_ATOM, 0, 2048);
-    }
-
-    if (dirty & WMStrut) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_STRUT), XCB_ATOM_CARDINAL, 0, 4);
-    }
-
-    if (dirty2 & WM2ExtendedStrut) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_STRUT_PARTIAL), XCB_ATOM_CARDINAL, 0, 12);
-    }
-
-    if (dirty2 & WM2FullscreenMonitors) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_NET_WM_FULLSCREEN_MONITORS),
-                                        XCB_ATOM_CARDINAL,
-                                        0,
-                                        4);
-    }
-
-    if (dirty & WMIconGeometry) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_ICON_GEOMETRY), XCB_ATOM_CARDINAL, 0, 4);
-    }
-
-    if (dirty & WMIcon) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_ICON), XCB_ATOM_CARDINAL, 0, 0xffffffff);
-    }
-
-    if (dirty & WMFrameExtents) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_FRAME_EXTENTS), XCB_ATOM_CARDINAL, 0, 4);
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_KDE_NET_WM_FRAME_STRUT), XCB_ATOM_CARDINAL, 0, 4);
-    }
-
-    if (dirty2 & WM2FrameOverlap) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_FRAME_OVERLAP), XCB_ATOM_CARDINAL, 0, 4);
-    }
-
-    if (dirty2 & WM2Activities) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_KDE_NET_WM_ACTIVITIES),
-                                        XCB_ATOM_STRING,
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty2 & WM2BlockCompositing) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_KDE_NET_WM_BLOCK_COMPOSITING),
-                                        XCB_ATOM_CARDINAL,
-                                        0,
-                                        1);
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_BYPASS_COMPOSITOR), XCB_ATOM_CARDINAL, 0, 1);
-    }
-
-    if (dirty & WMPid) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_PID), XCB_ATOM_CARDINAL, 0, 1);
-    }
-
-    if (dirty2 & WM2StartupId) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_NET_STARTUP_ID),
-                                        p->atom(UTF8_STRING),
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty2 & WM2Opacity) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_WINDOW_OPACITY), XCB_ATOM_CARDINAL, 0, 1);
-    }
-
-    if (dirty2 & WM2AllowedActions) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_ALLOWED_ACTIONS), XCB_ATOM_ATOM, 0, 2048);
-    }
-
-    if (dirty2 & WM2UserTime) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_NET_WM_USER_TIME), XCB_ATOM_CARDINAL, 0, 1);
-    }
-
-    if (dirty2 & WM2TransientFor) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, XCB_ATOM_WM_TRANSIENT_FOR, XCB_ATOM_WINDOW, 0, 1);
-    }
-
-    if (dirty2
-        & (WM2GroupLeader | WM2Urgency | WM2Input | WM2InitialMappingState | WM2IconPixmap)) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, XCB_ATOM_WM_HINTS, XCB_ATOM_WM_HINTS, 0, 9);
-    }
-
-    if (dirty2 & WM2WindowClass) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, XCB_ATOM_WM_CLASS, XCB_ATOM_STRING, 0, MAX_PROP_SIZE);
-    }
-
-    if (dirty2 & WM2WindowRole) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(WM_WINDOW_ROLE), XCB_ATOM_STRING, 0, MAX_PROP_SIZE);
-    }
-
-    if (dirty2 & WM2ClientMachine) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        XCB_ATOM_WM_CLIENT_MACHINE,
-                                        XCB_ATOM_STRING,
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty2 & WM2Protocols) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(WM_PROTOCOLS), XCB_ATOM_ATOM, 0, 2048);
-    }
-
-    if (dirty2 & WM2OpaqueRegion) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_NET_WM_OPAQUE_REGION),
-                                        XCB_ATOM_CARDINAL,
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty2 & WM2DesktopFileName) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_KDE_NET_WM_DESKTOP_FILE),
-                                        p->atom(UTF8_STRING),
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty2 & WM2GTKApplicationId) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_GTK_APPLICATION_ID),
-                                        p->atom(UTF8_STRING),
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty2 & WM2GTKFrameExtents) {
-        cookies[c++] = xcb_get_property(
-            p->conn, false, p->window, p->atom(_GTK_FRAME_EXTENTS), XCB_ATOM_CARDINAL, 0, 4);
-    }
-
-    if (dirty2 & WM2AppMenuObjectPath) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_KDE_NET_WM_APPMENU_OBJECT_PATH),
-                                        XCB_ATOM_STRING,
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
-
-    if (dirty2 & WM2AppMenuServiceName) {
-        cookies[c++] = xcb_get_property(p->conn,
-                                        false,
-                                        p->window,
-                                        p->atom(_KDE_NET_WM_APPMENU_SERVICE_NAME),
-                                        XCB_ATOM_STRING,
-                                        0,
-                                        MAX_PROP_SIZE);
-    }
+    auto const cookies = request_properties(p->conn, p->window, p->atoms, dirty, dirty2);
+    read_properties(dirty, dirty2, cookies);
+}
 
-    c = 0;
+void win_info::read_properties(net::Properties dirty,
+                               net::Properties2 dirty2,
+                               std::vector<xcb_get_property_cookie_t> const& cookies)
+{
+    size_t c = 0;
 
     if (dirty & XAWMState) {
         p->mapping_state = Withdrawn;
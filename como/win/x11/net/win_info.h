@@ -20,6 +20,32 @@ struct win_info_private;
 template<class Z>
 class rarray;
 
+/**
+ * Property requests of a window sent ahead of the construction of its win_info. This allows to
+ * batch them with other requests. The win_info is then filled from the replies without another
+ * round trip.
+ */
+class COMO_EXPORT win_info_prefetch
+{
+public:
+    win_info_prefetch(xcb_connection_t* connection,
+                      xcb_window_t window,
+                      net::Properties properties,
+                      net::Properties2 properties2);
+    win_info_prefetch(win_info_prefetch&& other) noexcept;
+    win_info_prefetch& operator=(win_info_prefetch&& other) = delete;
+    ~win_info_prefetch();
+
+private:
+    xcb_connection_t* connection;
+    xcb_window_t window;
+    net::Properties properties;
+    net::Properties2 properties2;
+    std::vector<xcb_get_property_cookie_t> cookies;
+
+    friend class win_info;
+};
+
 class COMO_EXPORT win_info
 {
 public:
@@ -36,6 +62,8 @@ public:
              net::Properties properties,
              net::Properties2 properties2,
              Role role = Client);
+    /// Fills the info from the replies to the requests of @p prefetch.
+    win_info(xcb_window_t rootWindow, win_info_prefetch&& prefetch, Role role = Client);
     win_info(const win_info& wininfo);
     virtual ~win_info();
 
@@ -167,8 +195,17 @@ protected:
     }
 
 private:
+    void init(xcb_connection_t* connection,
+              xcb_window_t window,
+              xcb_window_t rootWindow,
+              net::Properties properties,
+              net::Properties2 properties2,
+              Role role);
     void update(net::Properties dirtyProperties,
                 net::Properties2 dirtyProperties2 = net::Properties2());
+    void read_properties(net::Properties dirty,
+                         net::Properties2 dirty2,
+                         std::vector<xcb_get_property_cookie_t> const& cookies);
     void updateWMState();
     void setIconInternal(net::rarray<net::icon>& icons,
                          int& icon_count,
@@ -272,6 +272,7 @@ void clear_space(Space& space)
     // "mutex" the stackingorder, since anything trying to access it from now on will find
     // many dangeling pointers and crash
     space.stacking.order.stack.clear();
+    space.stacking.order.render_restack_required = true;
 
     // Only release windows on X11.
     auto const is_x11 = space.base.operation_mode == base::operation_mode::x11;
@@ -32,6 +32,12 @@ public:
     {
     }
 
+    win_info(Win* window, xcb_window_t rwin, net::win_info_prefetch&& prefetch)
+        : net::win_info(rwin, std::move(prefetch), net::WindowManager)
+        , window(window)
+    {
+    }
+
     void changeDesktop(int desktop) override
     {
         send_window_to_subspace(window->space, window, desktop, true);
@@ -45,6 +45,7 @@ void add_controlled_window_to_space(Space& space, Win* win)
     if (!contains(space.stacking.order.stack, var_win(win))) {
         // It'll be updated later, and updateToolWindows() requires c to be in stacking.order.
         space.stacking.order.stack.push_back(win);
+        space.stacking.order.render_restack_required = true;
     }
 
     // This cannot be in manage(), because the client got added only now
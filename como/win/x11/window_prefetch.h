@@ -0,0 +1,90 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "client.h"
+
+#include <como/base/x11/xcb/extensions.h>
+#include <como/base/x11/xcb/property.h>
+#include <como/base/x11/xcb/proto.h>
+#include <como/win/x11/net/win_info.h>
+
+namespace como::win::x11
+{
+
+/**
+ * Requests for the state of an X11 window that is read when it is taken under control. All
+ * requests are sent in one batch on construction, so their replies arrive together and reading
+ * them costs a single round trip.
+ */
+struct window_prefetch {
+    template<typename Space>
+    window_prefetch(Space& space,
+                    xcb_window_t xcb_win,
+                    net::Properties properties,
+                    net::Properties2 properties2)
+        : attributes{space.base.x11_data.connection, xcb_win}
+        , geometry{space.base.x11_data.connection, xcb_win}
+        , info{space.base.x11_data.connection, xcb_win, properties, properties2}
+        , wm_client_leader{space.base.x11_data.connection,
+                           false,
+                           xcb_win,
+                           space.atoms->wm_client_leader,
+                           XCB_ATOM_WINDOW,
+                           0,
+                           10000}
+        , skip_close_animation{space.base.x11_data.connection,
+                               false,
+                               xcb_win,
+                               space.atoms->kde_skip_close_animation,
+                               XCB_ATOM_CARDINAL,
+                               0,
+                               1}
+        , show_on_screen_edge{space.base.x11_data.connection,
+                              false,
+                              xcb_win,
+                              space.atoms->kde_screen_edge_show,
+                              XCB_ATOM_CARDINAL,
+                              0,
+                              1}
+        , transient{space.base.x11_data.connection, xcb_win}
+        , sync_counter{
+              base::x11::xcb::extensions::self()->is_sync_available()
+                      && wants_sync_counter(space.base.operation_mode, space.base.x11_data)
+                  ? base::x11::xcb::property(space.base.x11_data.connection,
+                                             false,
+                                             xcb_win,
+                                             space.atoms->net_wm_sync_request_counter,
+                                             XCB_ATOM_CARDINAL,
+                                             0,
+                                             1)
+                  : base::x11::xcb::property(space.base.x11_data.connection)}
+        , shape{base::x11::xcb::extensions::self()->is_shape_available()
+                    ? base::x11::xcb::shape_extents(space.base.x11_data.connection, xcb_win)
+                    : base::x11::xcb::shape_extents(space.base.x11_data.connection)}
+    {
+    }
+
+    bool is_shape()
+    {
+        return !shape.is_null() && shape->bounding_shaped > 0;
+    }
+
+    base::x11::xcb::window_attributes attributes;
+    base::x11::xcb::geometry geometry;
+
+    /// Consumed by the win_info of the window.
+    net::win_info_prefetch info;
+
+    base::x11::xcb::property wm_client_leader;
+    base::x11::xcb::property skip_close_animation;
+    base::x11::xcb::property show_on_screen_edge;
+    base::x11::xcb::transient_for transient;
+    base::x11::xcb::property sync_counter;
+    base::x11::xcb::shape_extents shape;
+};
+
+}
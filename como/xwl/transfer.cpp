@@ -7,6 +7,8 @@ SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <como/base/logging.h>
 
+#include <cerrno>
+#include <fcntl.h>
 #include <unistd.h>
 
 namespace como::xwl
@@ -15,6 +17,9 @@ namespace como::xwl
 // in Bytes: equals 64KB
 constexpr uint32_t s_incrChunkSize = 63 * 1024;
 
+// Number of chunks read ahead from a Wayland source before reading is paused.
+constexpr uint32_t s_bufferedChunks = 4;
+
 transfer::transfer(xcb_atom_t selection,
                    qint32 fd,
                    xcb_timestamp_t timestamp,
@@ -26,6 +31,8 @@ transfer::transfer(xcb_atom_t selection,
     , fd{fd}
     , timestamp{timestamp}
 {
+    // The transfer is driven by socket notifiers and must never block the event loop.
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
 }
 
 void transfer::create_socket_notifier(QSocketNotifier::Type type)
@@ -71,6 +78,7 @@ wl_to_x11_transfer::wl_to_x11_transfer(xcb_atom_t selection,
                                        QObject* parent)
     : transfer(selection, fd, 0, x11, parent)
     , request(request)
+    , buffer{s_bufferedChunks * s_incrChunkSize}
 {
 }
 
@@ -89,30 +97,34 @@ void wl_to_x11_transfer::start_transfer_from_source()
     });
 }
 
-int wl_to_x11_transfer::flush_source_data()
+void wl_to_x11_transfer::flush_source_data()
 {
+    auto const data = buffer.read_space(s_incrChunkSize);
+
     xcb_change_property(x11.connection,
                         XCB_PROP_MODE_REPLACE,
                         request->requestor,
                         request->property,
                         request->target,
                         8,
-                        chunks.front().first.size(),
-                        chunks.front().first.data());
+                        data.size(),
+                        data.data());
     xcb_flush(x11.connection);
 
+    // The request is sent with the flush, so the space can be reused right away.
+    buffer.consume(data.size());
+
     property_is_set = true;
     reset_timeout();
 
-    auto const rm = chunks.front();
-    chunks.pop_front();
-    return rm.first.size();
+    if (auto notifier = socket_notifier(); notifier && !notifier->isEnabled()) {
+        // There is space again for reading from the source.
+        notifier->setEnabled(true);
+    }
 }
 
 void wl_to_x11_transfer::start_incr()
 {
-    Q_ASSERT(chunks.size() == 1);
-
     uint32_t mask[] = {XCB_EVENT_MASK_PROPERTY_CHANGE};
     xcb_change_window_attributes(x11.connection, request->requestor, XCB_CW_EVENT_MASK, mask);
 
@@ -129,70 +141,84 @@ void wl_to_x11_transfer::start_incr()
     xcb_flush(x11.connection);
 
     set_incr(true);
-    // first data will be flushed after the property has been deleted
-    // again by the requestor
-    flush_property_on_delete = true;
+
+    // First data will be flushed after the property has been deleted again by the requestor.
     property_is_set = true;
     Q_EMIT selection_notify(request, true);
 }
 
-void wl_to_x11_transfer::read_wl_source()
+void wl_to_x11_transfer::finish_incr()
 {
-    if (chunks.size() == 0 || chunks.back().second == s_incrChunkSize) {
-        // append new chunk
-        auto next = std::pair<QByteArray, int>();
-        next.first.resize(s_incrChunkSize);
-        next.second = 0;
-        chunks.push_back(next);
-    }
+    uint32_t mask[] = {0};
+    xcb_change_window_attributes(x11.connection, request->requestor, XCB_CW_EVENT_MASK, mask);
 
-    auto const oldLen = chunks.back().second;
-    auto const avail = s_incrChunkSize - chunks.back().second;
-    Q_ASSERT(avail > 0);
+    // A property of zero length marks the end of the incremental transfer.
+    xcb_change_property(x11.connection,
+                        XCB_PROP_MODE_REPLACE,
+                        request->requestor,
+                        request->property,
+                        request->target,
+                        8,
+                        0,
+                        nullptr);
+    xcb_flush(x11.connection);
+    end_transfer();
+}
 
-    ssize_t readLen = read(get_fd(), chunks.back().first.data() + oldLen, avail);
+void wl_to_x11_transfer::read_wl_source()
+{
+    auto const space = buffer.write_space();
+    Q_ASSERT(!space.empty());
+
+    ssize_t readLen = read(get_fd(), space.data(), space.size());
     if (readLen == -1) {
+        if (errno == EAGAIN || errno == EINTR) {
+            return;
+        }
         qCWarning(KWIN_CORE) << "Error reading in Wl data.";
 
         // TODO: cleanup X side?
         end_transfer();
         return;
     }
-    chunks.back().second = oldLen + readLen;
+
+    buffer.commit(readLen);
+    reset_timeout();
 
     if (readLen == 0) {
         // at the fd end - complete transfer now
-        chunks.back().first.resize(chunks.back().second);
+        source_at_end = true;
+        clear_socket_notifier();
 
         if (get_incr()) {
-            // incremental transfer is to be completed now
-            flush_property_on_delete = true;
             if (!property_is_set) {
-                // flush if target's property is not set at the moment
-                flush_source_data();
+                // the requestor waits for the next chunk or the end
+                buffer.empty() ? finish_incr() : flush_source_data();
             }
-            clear_socket_notifier();
         } else {
-            // non incremental transfer is to be completed now,
-            // data can be transferred to X client via a single property set
+            // Non incremental transfer is to be completed now. The data fits into a single chunk
+            // and can be transferred to the X client via a single property set.
             flush_source_data();
             Q_EMIT selection_notify(request, true);
             end_transfer();
         }
-    } else if (chunks.back().second == s_incrChunkSize) {
-        // first chunk full, but not yet at fd end -> go incremental
-        if (get_incr()) {
-            flush_property_on_delete = true;
-            if (!property_is_set) {
-                // flush if target's property is not set at the moment
-                flush_source_data();
-            }
-        } else {
-            // starting incremental transfer
+        return;
+    }
+
+    if (!get_incr()) {
+        if (buffer.size() >= s_incrChunkSize) {
+            // more data than fits into a single chunk -> go incremental
             start_incr();
         }
+    } else if (!property_is_set) {
+        // the requestor waits for the next chunk
+        flush_source_data();
+    }
+
+    if (buffer.full()) {
+        // Stop reading until the requestor has taken more data.
+        socket_notifier()->setEnabled(false);
     }
-    reset_timeout();
 }
 
 bool wl_to_x11_transfer::handle_property_notify(xcb_property_notify_event_t* event)
@@ -214,29 +240,13 @@ void wl_to_x11_transfer::handle_property_delete()
     }
     property_is_set = false;
 
-    if (flush_property_on_delete) {
-        if (!socket_notifier() && chunks.empty()) {
-            // transfer complete
-
-            uint32_t mask[] = {0};
-            xcb_change_window_attributes(
-                x11.connection, request->requestor, XCB_CW_EVENT_MASK, mask);
-
-            xcb_change_property(x11.connection,
-                                XCB_PROP_MODE_REPLACE,
-                                request->requestor,
-                                request->property,
-                                request->target,
-                                8,
-                                0,
-                                nullptr);
-            xcb_flush(x11.connection);
-            flush_property_on_delete = false;
-            end_transfer();
-        } else {
-            flush_source_data();
-        }
+    if (!buffer.empty()) {
+        flush_source_data();
+    } else if (source_at_end) {
+        finish_incr();
     }
+
+    // Otherwise the next chunk is flushed once more data has been read from the source.
 }
 
 x11_to_wl_transfer::x11_to_wl_transfer(xcb_atom_t selection,
@@ -327,15 +337,7 @@ bool x11_to_wl_transfer::handle_selection_notify(xcb_selection_notify_event_t* e
 
 void x11_to_wl_transfer::start_transfer()
 {
-    auto cookie = xcb_get_property(x11.connection,
-                                   1,
-                                   window,
-                                   x11.atoms->wl_selection,
-                                   XCB_GET_PROPERTY_TYPE_ANY,
-                                   0,
-                                   0x1fffffff);
-
-    auto reply = xcb_get_property_reply(x11.connection, cookie, nullptr);
+    auto reply = get_property_part();
     if (reply == nullptr) {
         qCWarning(KWIN_CORE) << "Can't get selection property.";
         end_transfer();
@@ -345,10 +347,14 @@ void x11_to_wl_transfer::start_transfer()
     if (reply->type == x11.atoms->incr) {
         set_incr(true);
         free(reply);
+
+        // Deleting the property requests the first chunk.
+        property_offset = 0;
+        xcb_delete_property(x11.connection, window, x11.atoms->wl_selection);
+        xcb_flush(x11.connection);
     } else {
         set_incr(false);
-        // reply's ownership is transferred
-        receiver->transfer_from_property(reply);
+        receive_property_part(reply);
         data_source_write();
     }
 }
@@ -364,15 +370,7 @@ void x11_to_wl_transfer::get_incr_chunk()
         return;
     }
 
-    auto cookie = xcb_get_property(x11.connection,
-                                   0,
-                                   window,
-                                   x11.atoms->wl_selection,
-                                   XCB_GET_PROPERTY_TYPE_ANY,
-                                   0,
-                                   0x1fffffff);
-
-    auto reply = xcb_get_property_reply(x11.connection, cookie, nullptr);
+    auto reply = get_property_part();
     if (!reply) {
         qCWarning(KWIN_CORE) << "Can't get selection property.";
         end_transfer();
@@ -380,8 +378,7 @@ void x11_to_wl_transfer::get_incr_chunk()
     }
 
     if (xcb_get_property_value_length(reply) > 0) {
-        // reply's ownership is transferred
-        receiver->transfer_from_property(reply);
+        receive_property_part(reply);
         data_source_write();
     } else {
         // transfer complete
@@ -390,6 +387,32 @@ void x11_to_wl_transfer::get_incr_chunk()
     }
 }
 
+xcb_get_property_reply_t* x11_to_wl_transfer::get_property_part()
+{
+    // Large properties are read in parts of the chunk size, so they are never held in memory as a
+    // whole. The length is in 32-bit units.
+    uint32_t const length = receiver->needs_full_property() ? 0x1fffffff : s_incrChunkSize / 4;
+
+    auto cookie = xcb_get_property(x11.connection,
+                                   0,
+                                   window,
+                                   x11.atoms->wl_selection,
+                                   XCB_GET_PROPERTY_TYPE_ANY,
+                                   property_offset,
+                                   length);
+    return xcb_get_property_reply(x11.connection, cookie, nullptr);
+}
+
+void x11_to_wl_transfer::receive_property_part(xcb_get_property_reply_t* reply)
+{
+    // All parts but the last one have the full requested length, a multiple of 4.
+    property_offset += xcb_get_property_value_length(reply) / 4;
+    property_remaining = reply->bytes_after;
+
+    // reply's ownership is transferred
+    receiver->transfer_from_property(reply);
+}
+
 data_receiver::~data_receiver()
 {
     if (property_reply) {
@@ -512,36 +535,58 @@ void moz_url_receiver::set_data(char const* value, int length)
 
 void x11_to_wl_transfer::data_source_write()
 {
-    auto property = receiver->get_data();
+    while (true) {
+        auto property = receiver->get_data();
+
+        auto len = write(get_fd(), property.constData(), property.size());
+        if (len == -1) {
+            if (errno != EAGAIN && errno != EINTR) {
+                qCWarning(KWIN_CORE) << "X11 to Wayland write error on fd:" << get_fd();
+                end_transfer();
+                return;
+            }
+            len = 0;
+        }
 
-    auto len = write(get_fd(), property.constData(), property.size());
-    if (len == -1) {
-        qCWarning(KWIN_CORE) << "X11 to Wayland write error on fd:" << get_fd();
-        end_transfer();
-        return;
-    }
+        receiver->part_read(len);
+        reset_timeout();
+
+        if (len < property.size()) {
+            // Wait until the receiving client has read from the fd.
+            if (!socket_notifier()) {
+                create_socket_notifier(QSocketNotifier::Write);
+                connect(socket_notifier(), &QSocketNotifier::activated, this, [this](int socket) {
+                    Q_UNUSED(socket);
+                    data_source_write();
+                });
+            }
+            return;
+        }
 
-    receiver->part_read(len);
-    if (len == property.size()) {
-        // property completely transferred
-        if (get_incr()) {
-            clear_socket_notifier();
-            xcb_delete_property(x11.connection, window, x11.atoms->wl_selection);
-            xcb_flush(x11.connection);
-        } else {
-            // transfer complete
-            end_transfer();
+        if (property_remaining == 0) {
+            break;
         }
-    } else {
-        if (!socket_notifier()) {
-            create_socket_notifier(QSocketNotifier::Write);
-            connect(socket_notifier(), &QSocketNotifier::activated, this, [this](int socket) {
-                Q_UNUSED(socket);
-                data_source_write();
-            });
+
+        // Write the next part of the property until the fd would block.
+        auto reply = get_property_part();
+        if (!reply) {
+            qCWarning(KWIN_CORE) << "Can't get selection property.";
+            end_transfer();
+            return;
         }
+        receive_property_part(reply);
+    }
+
+    // property completely transferred
+    clear_socket_notifier();
+    property_offset = 0;
+    xcb_delete_property(x11.connection, window, x11.atoms->wl_selection);
+    xcb_flush(x11.connection);
+
+    if (!get_incr()) {
+        // transfer complete
+        end_transfer();
     }
-    reset_timeout();
 }
 
 }
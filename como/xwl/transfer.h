@@ -6,11 +6,11 @@ SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
 
 #include "como_export.h"
+#include "transfer_buffer.h"
 #include "types.h"
 
 #include <QObject>
 #include <QSocketNotifier>
-#include <deque>
 
 #include <xcb/xcb.h>
 
@@ -118,18 +118,17 @@ Q_SIGNALS:
 private:
     void start_incr();
     void read_wl_source();
-    int flush_source_data();
+    void flush_source_data();
+    void finish_incr();
     void handle_property_delete();
 
     xcb_selection_request_event_t* request = nullptr;
 
-    /* contains all received data portioned in chunks
-     * TODO(romangg): explain second std::pair component
-     */
-    std::deque<std::pair<QByteArray, int>> chunks;
+    /// Data read from the Wayland source that has not yet been set on the X11 property.
+    transfer_buffer buffer;
 
     bool property_is_set = false;
-    bool flush_property_on_delete = false;
+    bool source_at_end = false;
 
     Q_DISABLE_COPY(wl_to_x11_transfer)
 };
@@ -147,6 +146,12 @@ public:
     virtual void set_data(char const* value, int length);
     QByteArray get_data() const;
 
+    /// Whether the property must be read at once instead of in parts.
+    virtual bool needs_full_property() const
+    {
+        return false;
+    }
+
     void part_read(int length);
 
 protected:
@@ -169,6 +174,10 @@ class netscape_url_receiver : public data_receiver
 {
 public:
     void set_data(char const* value, int length) override;
+    bool needs_full_property() const override
+    {
+        return true;
+    }
 };
 
 /**
@@ -179,6 +188,10 @@ class moz_url_receiver : public data_receiver
 {
 public:
     void set_data(char const* value, int length) override;
+    bool needs_full_property() const override
+    {
+        return true;
+    }
 };
 
 /**
@@ -205,10 +218,17 @@ private:
     void data_source_write();
     void start_transfer();
     void get_incr_chunk();
+    xcb_get_property_reply_t* get_property_part();
+    void receive_property_part(xcb_get_property_reply_t* reply);
 
     xcb_window_t window;
     data_receiver* receiver = nullptr;
 
+    /// Offset in 32-bit units of the next part to read from the current property.
+    uint32_t property_offset{0};
+    /// Bytes of the current property that have not yet been read.
+    uint32_t property_remaining{0};
+
     Q_DISABLE_COPY(x11_to_wl_transfer)
 };
 
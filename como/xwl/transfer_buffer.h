@@ -0,0 +1,97 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace como::xwl
+{
+
+/**
+ * Ring buffer of fixed capacity for data in transit between a file descriptor and an X11
+ * property. Data is written to and read from the buffer in place, so the caller must not write
+ * more than the current write space and must not read more than the current read space.
+ *
+ * Memory is only allocated on first write.
+ */
+class transfer_buffer
+{
+public:
+    explicit transfer_buffer(size_t capacity)
+        : capacity{capacity}
+    {
+        assert(capacity > 0);
+    }
+
+    /// Contiguous free space at the end of the buffer. Empty when the buffer is full.
+    std::span<char> write_space()
+    {
+        if (storage.empty()) {
+            storage.resize(capacity);
+        }
+
+        auto const tail = (head + count) % capacity;
+        auto const contiguous = tail < head || count == capacity ? head - tail : capacity - tail;
+        return {storage.data() + tail, contiguous};
+    }
+
+    /// Marks @p size bytes of the current write space as written.
+    void commit(size_t size)
+    {
+        assert(size <= capacity - count);
+        count += size;
+    }
+
+    /// Contiguous data at the start of the buffer of at most @p max_size bytes.
+    std::span<char const> read_space(size_t max_size) const
+    {
+        if (count == 0) {
+            return {};
+        }
+        auto const contiguous = std::min(count, capacity - head);
+        return {storage.data() + head, std::min(contiguous, max_size)};
+    }
+
+    /// Marks @p size bytes of the current read space as read.
+    void consume(size_t size)
+    {
+        assert(size <= count);
+        head = (head + size) % capacity;
+        count -= size;
+
+        if (count == 0) {
+            // Restart at the front so small transfers stay contiguous.
+            head = 0;
+        }
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    bool full() const
+    {
+        return count == capacity;
+    }
+
+private:
+    size_t capacity;
+    std::vector<char> storage;
+    size_t head{0};
+    size_t count{0};
+};
+
+}
@@ -63,6 +63,9 @@ BlurEffect::BlurEffect()
         handle_screen_added(screen);
     }
 
+    QObject::connect(
+        effects, &EffectsHandler::windowDeleted, this, &BlurEffect::handle_window_deleted);
+
     if (shader && shader->isValid() && render_targets_are_valid) {
         auto& blur_integration = effects->get_blur_integration();
         auto update = [this](auto&& data) { update_function(*this, data); };
@@ -88,6 +91,8 @@ static bool check_render_targets_are_valid(std::vector<blur_render_target> const
 
 void BlurEffect::update_texture()
 {
+    caches.clear();
+
     render_targets_are_valid = true;
     for (auto& [key, data] : render_screens) {
         update_texture(data);
@@ -141,6 +146,14 @@ void BlurEffect::update_texture(blur_render_data& screen)
     // This last set is used as a temporary helper texture
     screen.targets.emplace_back(std::make_unique<GLTexture>(textureFormat, screen_size));
 
+    update_stack(screen);
+
+    // Invalidate noise texture
+    noise_texture = {};
+}
+
+void BlurEffect::update_stack(blur_render_data& screen)
+{
     screen.stack = {};
 
     // Upsample
@@ -155,9 +168,22 @@ void BlurEffect::update_texture(blur_render_data& screen)
 
     // Copysample (with the original sized target)
     screen.stack.push(screen.targets.front().fbo.get());
+}
 
-    // Invalidate noise texture
-    noise_texture = {};
+void BlurEffect::store_in_cache(blur_render_data& screen, blur_cache& cache)
+{
+    // The blurred background is in the first downsized target. Instead of copying it we hand the
+    // target over to the cache and continue with the previous target of the cache.
+    auto& target = screen.targets.at(1);
+
+    if (!cache.target || cache.target->texture->size() != target.texture->size()
+        || cache.target->texture->internalFormat() != target.texture->internalFormat()) {
+        cache.target.emplace(std::make_unique<GLTexture>(target.texture->internalFormat(),
+                                                         target.texture->size()));
+    }
+
+    std::swap(*cache.target, target);
+    update_stack(screen);
 }
 
 void BlurEffect::init_blur_strength_values()
@@ -278,10 +304,16 @@ void BlurEffect::handle_screen_added(EffectScreen const* screen)
 
 void BlurEffect::handle_screen_removed(EffectScreen const* screen)
 {
+    std::erase_if(caches, [screen](auto const& entry) { return entry.first.second == screen; });
     render_screens.erase(screen);
     update_texture();
 }
 
+void BlurEffect::handle_window_deleted(EffectWindow const* window)
+{
+    std::erase_if(caches, [window](auto const& entry) { return entry.first.first == window; });
+}
+
 bool BlurEffect::deco_supports_blur_behind(EffectWindow const* win) const
 {
     return win->decoration() && !win->decoration()->blurRegion().isNull();
@@ -402,6 +434,19 @@ void BlurEffect::prePaintScreen(effect::screen_prepaint_data& data)
     current_blur_area = {};
 
     current_screen = &data.screen;
+    if (auto it = render_screens.find(current_screen); it != render_screens.end()) {
+        auto const frame = ++it->second.frame;
+
+        // A cache is only reused when its window was painted in the previous frame. Release the
+        // screen-sized targets of windows that were not, they can not become valid again.
+        for (auto& [key, cache] : caches) {
+            if (key.second == current_screen && cache.target && cache.frame + 1 < frame) {
+                cache.target.reset();
+                cache.valid = false;
+            }
+        }
+    }
+
     effects->prePaintScreen(data);
 }
 
@@ -411,6 +456,13 @@ void BlurEffect::postPaintScreen()
     effects->postPaintScreen();
 }
 
+// Docks and their transients are blurred without the area around them.
+static bool blurs_as_dock(EffectWindow& win)
+{
+    auto modal = win.transientFor();
+    return win.isDock() || (modal && modal->isDock());
+}
+
 void BlurEffect::prePaintWindow(effect::window_prepaint_data& data)
 {
     // This effect relies on prePaintWindow being called in the bottom to top order.
@@ -446,9 +498,23 @@ void BlurEffect::prePaintWindow(effect::window_prepaint_data& data)
     auto const blurArea = blur_region(&data.window).translated(data.window.pos()) & screen_geo;
     auto const expandedBlur = (data.window.isDock() ? blurArea : expand(blurArea)) & screen_geo;
 
-    // if this window or a window underneath the blurred area is painted again we have to
-    // blur everything
-    if (painted_area.intersects(expandedBlur) || data.paint.region.intersects(blurArea)) {
+    auto cache_is_valid{false};
+    if (!blurArea.isEmpty()) {
+        auto const& screen_data = render_screens.at(current_screen);
+        auto& cache = caches[{&data.window, current_screen}];
+
+        // Content below might have changed when the window was not painted in the previous frame.
+        if (painted_area.intersects(expandedBlur) || cache.frame + 1 != screen_data.frame) {
+            cache.valid = false;
+        }
+        cache.frame = screen_data.frame;
+        cache_is_valid = is_cache_valid(cache, blurArea, blurArea, blurs_as_dock(data.window));
+    }
+
+    // If a window underneath the blurred area is painted again we have to blur everything. If
+    // only this window is painted again we can blur everything or reuse the cached background.
+    if (painted_area.intersects(expandedBlur)
+        || (!cache_is_valid && data.paint.region.intersects(blurArea))) {
         data.paint.region |= expandedBlur;
         // we have to check again whether we do not damage a blurred area
         // of a window
@@ -463,6 +529,15 @@ void BlurEffect::prePaintWindow(effect::window_prepaint_data& data)
     painted_area |= data.paint.region;
 }
 
+bool BlurEffect::is_cache_valid(blur_cache const& cache,
+                                QRegion const& area,
+                                QRegion const& shape,
+                                bool isDock) const
+{
+    return cache.valid && cache.target && cache.dock == isDock && cache.area == area
+        && (shape - cache.region).isEmpty();
+}
+
 bool BlurEffect::should_blur(effect::window_paint_data const& data) const
 {
     if (!render_targets_are_valid || !shader || !shader->isValid()) {
@@ -530,12 +605,8 @@ void BlurEffect::drawWindow(effect::window_paint_data& data)
         shape = translated;
     }
 
-    auto modal = data.window.transientFor();
-    auto const transientForIsDock = (modal ? modal->isDock() : false);
-
-    do_blur(data,
-            shape & data.paint.region & current_screen->geometry(),
-            data.window.isDock() || transientForIsDock);
+    auto const area = shape & current_screen->geometry();
+    do_blur(data, area, area & data.paint.region, blurs_as_dock(data.window));
 
     // Draw the window over the blurred area
     effects->drawWindow(data);
@@ -576,7 +647,10 @@ static QMatrix4x4 get_screen_projection(blur_render_data const& data)
     return proj;
 }
 
-void BlurEffect::do_blur(effect::window_paint_data& data, QRegion const& shape, bool isDock)
+void BlurEffect::do_blur(effect::window_paint_data& data,
+                         QRegion const& area,
+                         QRegion const& shape,
+                         bool isDock)
 {
     if (shape.isEmpty()) {
         return;
@@ -585,9 +659,12 @@ void BlurEffect::do_blur(effect::window_paint_data& data, QRegion const& shape,
     auto const opacity = data.paint.opacity * data.window.opacity();
 
     assert(current_screen);
-    auto const& screen_data = render_screens.at(current_screen);
+    auto& screen_data = render_screens.at(current_screen);
+    auto& cache = caches[{&data.window, current_screen}];
+    auto const cached = is_cache_valid(cache, area, shape, isDock);
+
     auto const screen_geo = current_screen->geometry();
-    auto const expanded_blur_region = expand(shape) & expand(screen_geo);
+    auto const expanded_blur_region = cached ? QRegion() : expand(shape) & expand(screen_geo);
     auto const use_srgb = screen_data.targets.front().texture->internalFormat() == GL_SRGB8_ALPHA8;
 
     if (use_srgb) {
@@ -600,36 +677,52 @@ void BlurEffect::do_blur(effect::window_paint_data& data, QRegion const& shape,
 
     upload_geometry(vbo, expanded_blur_region, shape);
 
-    auto const logicalSourceRect = expanded_blur_region.boundingRect() & screen_geo;
     int blurRectCount = expanded_blur_region.rectCount() * 6;
 
-    /*
-     * If the window is a dock or panel we avoid the "extended blur" effect.
-     * Extended blur is when windows that are not under the blurred area affect
-     * the final blur result.
-     * We want to avoid this on panels, because it looks really weird and ugly
-     * when maximized windows or windows near the panel affect the dock blur.
-     */
-    if (isDock) {
-        screen_data.targets.back().fbo->blit_from_current_render_target(
-            data.render, logicalSourceRect, logicalSourceRect.translated(-screen_geo.topLeft()));
-        render::push_framebuffers(data.render, screen_data.stack);
-
+    if (cached) {
         vbo->bindArrays();
-        copy_screen_sample_texture(
-            data.render, screen_data, vbo, blurRectCount, shape.boundingRect());
     } else {
-        screen_data.targets.front().fbo->blit_from_current_render_target(
-            data.render, logicalSourceRect, logicalSourceRect.translated(-screen_geo.topLeft()));
-        render::push_framebuffers(data.render, screen_data.stack);
+        auto const logicalSourceRect = expanded_blur_region.boundingRect() & screen_geo;
+
+        /*
+         * If the window is a dock or panel we avoid the "extended blur" effect.
+         * Extended blur is when windows that are not under the blurred area affect
+         * the final blur result.
+         * We want to avoid this on panels, because it looks really weird and ugly
+         * when maximized windows or windows near the panel affect the dock blur.
+         */
+        if (isDock) {
+            screen_data.targets.back().fbo->blit_from_current_render_target(
+                data.render,
+                logicalSourceRect,
+                logicalSourceRect.translated(-screen_geo.topLeft()));
+            render::push_framebuffers(data.render, screen_data.stack);
+
+            vbo->bindArrays();
+            copy_screen_sample_texture(
+                data.render, screen_data, vbo, blurRectCount, shape.boundingRect());
+        } else {
+            screen_data.targets.front().fbo->blit_from_current_render_target(
+                data.render,
+                logicalSourceRect,
+                logicalSourceRect.translated(-screen_geo.topLeft()));
+            render::push_framebuffers(data.render, screen_data.stack);
+
+            // Remove the screen_data.targets.front() from the top of the stack that we will not
+            // use.
+            render::pop_framebuffer(data.render);
+        }
 
-        // Remove the screen_data.targets.front() from the top of the stack that we will not use.
-        render::pop_framebuffer(data.render);
-    }
+        vbo->bindArrays();
+        downsample_texture(data.render, screen_data, vbo, blurRectCount);
+        upsample_texture(data.render, screen_data, vbo, blurRectCount);
 
-    vbo->bindArrays();
-    downsample_texture(data.render, screen_data, vbo, blurRectCount);
-    upsample_texture(data.render, screen_data, vbo, blurRectCount);
+        store_in_cache(screen_data, cache);
+        cache.region = shape;
+        cache.area = area;
+        cache.dock = isDock;
+        cache.valid = true;
+    }
 
     // Modulate the blurred texture with the window opacity if the window isn't opaque
     if (opacity < 1.0) {
@@ -645,7 +738,9 @@ void BlurEffect::do_blur(effect::window_paint_data& data, QRegion const& shape,
         glBlendFunc(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA);
     }
 
-    upsample_to_screen(screen_data, data, vbo, blurRectCount, shape.rectCount() * 6);
+    // The blurred background is reused until something below the window changes.
+    upsample_to_screen(
+        screen_data, *cache.target->texture, data, vbo, blurRectCount, shape.rectCount() * 6);
 
     if (use_srgb) {
         glDisable(GL_FRAMEBUFFER_SRGB);
@@ -680,13 +775,13 @@ void BlurEffect::do_blur(effect::window_paint_data& data, QRegion const& shape,
 }
 
 void BlurEffect::upsample_to_screen(blur_render_data const& data,
+                                    GLTexture& texture,
                                     effect::window_paint_data const& win_data,
                                     GLVertexBuffer* vbo,
                                     int vboStart,
                                     int blurRectCount)
 {
-    auto const& tex = data.targets.at(1).texture;
-    tex->bind();
+    texture.bind();
 
     shader->bind(BlurShader::UpSampleType);
 
@@ -15,8 +15,11 @@
 
 #include <QVector2D>
 #include <QVector>
+#include <map>
+#include <optional>
 #include <span>
 #include <stack>
+#include <utility>
 #include <vector>
 
 namespace como
@@ -43,6 +46,26 @@ struct blur_render_data {
     EffectScreen const& screen;
     std::vector<blur_render_target> targets;
     std::stack<GLFramebuffer*> stack;
+
+    // Counts the painted frames to detect windows that were not painted in the previous one.
+    uint64_t frame{0};
+};
+
+/**
+ * Blurred background of a window on a screen. It is reused as long as nothing changed below the
+ * expanded blur region of the window.
+ */
+struct blur_cache {
+    std::optional<blur_render_target> target;
+
+    // Part of the blur area the target holds the blurred background for.
+    QRegion region;
+    // The blur area of the window on the screen at the time the target was rendered.
+    QRegion area;
+    bool dock{false};
+
+    uint64_t frame{0};
+    bool valid{false};
 };
 
 class BlurEffect : public como::Effect
@@ -77,16 +100,26 @@ public:
 private:
     void handle_screen_added(EffectScreen const* screen);
     void handle_screen_removed(EffectScreen const* screen);
+    void handle_window_deleted(EffectWindow const* window);
     QRect expand(QRect const& rect) const;
     QRegion expand(QRegion const& region) const;
     void init_blur_strength_values();
     void update_texture();
     void update_texture(blur_render_data& data);
+    void update_stack(blur_render_data& data);
+    void store_in_cache(blur_render_data& data, blur_cache& cache);
     QRegion blur_region(EffectWindow const* win) const;
     QRegion deco_blur_region(EffectWindow const* win) const;
     bool deco_supports_blur_behind(EffectWindow const* win) const;
     bool should_blur(effect::window_paint_data const& data) const;
-    void do_blur(effect::window_paint_data& data, QRegion const& shape, bool isDock);
+    bool is_cache_valid(blur_cache const& cache,
+                        QRegion const& area,
+                        QRegion const& shape,
+                        bool isDock) const;
+    void do_blur(effect::window_paint_data& data,
+                 QRegion const& area,
+                 QRegion const& shape,
+                 bool isDock);
     void upload_region(std::span<QVector2D> const map, size_t& index, QRegion const& region);
     void upload_geometry(GLVertexBuffer* vbo,
                          QRegion const& expanded_blur_region,
@@ -94,6 +127,7 @@ private:
     void generate_noise_texture();
 
     void upsample_to_screen(blur_render_data const& data,
+                            GLTexture& texture,
                             effect::window_paint_data const& win_data,
                             GLVertexBuffer* vbo,
                             int vboStart,
@@ -122,6 +156,8 @@ private:
     std::unordered_map<EffectScreen const*, blur_render_data> render_screens;
     bool render_targets_are_valid{false};
 
+    std::map<std::pair<EffectWindow const*, EffectScreen const*>, blur_cache> caches;
+
     EffectScreen const* current_screen{nullptr};
 
     GLTexture noise_texture;
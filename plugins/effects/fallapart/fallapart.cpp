@@ -230,4 +230,9 @@ bool FallApartEffect::isActive() const
     return !windows.isEmpty();
 }
 
+bool FallApartEffect::isActiveFor(EffectWindow const* window) const
+{
+    return windows.contains(const_cast<EffectWindow*>(window));
+}
+
 } // namespace
@@ -32,6 +32,7 @@ public:
     void prePaintWindow(effect::window_prepaint_data& data) override;
     void postPaintScreen() override;
     bool isActive() const override;
+    bool isActiveFor(EffectWindow const* window) const override;
 
     int requestedEffectChainPosition() const override
     {
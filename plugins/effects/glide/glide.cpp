@@ -148,6 +148,11 @@ bool GlideEffect::isActive() const
     return !m_animations.isEmpty();
 }
 
+bool GlideEffect::isActiveFor(EffectWindow const* window) const
+{
+    return m_animations.contains(const_cast<EffectWindow*>(window));
+}
+
 bool GlideEffect::supported()
 {
     return effects->isOpenGLCompositing() && effects->animationsSupported();
@@ -48,6 +48,7 @@ public:
     void postPaintScreen() override;
 
     bool isActive() const override;
+    bool isActiveFor(EffectWindow const* window) const override;
     int requestedEffectChainPosition() const override;
 
     static bool supported();
@@ -497,4 +497,9 @@ bool MagicLampEffect::isActive() const
     return !m_animations.isEmpty();
 }
 
+bool MagicLampEffect::isActiveFor(EffectWindow const* window) const
+{
+    return m_animations.contains(const_cast<EffectWindow*>(window));
+}
+
 } // namespace
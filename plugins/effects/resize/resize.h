@@ -27,6 +27,10 @@ public:
     {
         return m_active || AnimationEffect::isActive();
     }
+    inline bool isActiveFor(EffectWindow const* window) const override
+    {
+        return (m_active && window == m_resizeWindow) || AnimationEffect::isActiveFor(window);
+    }
     void prePaintScreen(effect::screen_prepaint_data& data) override;
     void prePaintWindow(effect::window_prepaint_data& data) override;
     void paintWindow(effect::window_paint_data& data) override;
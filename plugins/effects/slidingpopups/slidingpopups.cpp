@@ -360,4 +360,9 @@ bool SlidingPopupsEffect::isActive() const
     return !animations.isEmpty();
 }
 
+bool SlidingPopupsEffect::isActiveFor(EffectWindow const* window) const
+{
+    return animations.contains(const_cast<EffectWindow*>(window));
+}
+
 }
@@ -30,6 +30,7 @@ public:
     void postPaintWindow(EffectWindow* win) override;
     void reconfigure(ReconfigureFlags flags) override;
     bool isActive() const override;
+    bool isActiveFor(EffectWindow const* window) const override;
 
     int requestedEffectChainPosition() const override
     {
@@ -0,0 +1,70 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<uint64_t> allocations{0};
+
+void* allocate(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+}
+
+namespace como::detail::test::bench
+{
+
+uint64_t allocation_count()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+}
+
+// Replacements of the global allocation functions to count allocations. They apply to all
+// libraries loaded into the process, so allocations of the compositor are counted too.
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
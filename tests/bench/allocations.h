@@ -0,0 +1,16 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include <cstdint>
+
+namespace como::detail::test::bench
+{
+
+/// Number of heap allocations done through operator new in the whole process since its start.
+uint64_t allocation_count();
+
+}
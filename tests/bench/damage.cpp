@@ -0,0 +1,71 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "scenario.h"
+
+#include <Wrapland/Client/surface.h>
+#include <Wrapland/Client/xdg_shell.h>
+
+using namespace std::chrono_literals;
+
+namespace como::detail::test::bench
+{
+
+TEST_CASE("damage commits", "[bench]")
+{
+    std::string const name{"damage-commits"};
+    constexpr auto commit_interval = std::chrono::nanoseconds(1s) / 144;
+    constexpr auto duration = 3s;
+
+    auto setup = create_setup("bench-" + name);
+    setup_wayland_connection();
+
+    auto surface = create_surface();
+    auto toplevel = create_xdg_shell_toplevel(surface);
+    REQUIRE(toplevel);
+
+    auto const size = QSize(1000, 800);
+    auto window = render_and_wait_for_shown(surface, size, Qt::blue);
+    REQUIRE(window);
+
+    auto& output = get_render_output(*setup);
+    output.telemetry.reset();
+
+    measurement total;
+    auto next_commit = std::chrono::nanoseconds::zero();
+    int commits{0};
+
+    // The client damages its whole surface with every commit.
+    while (total.elapsed() < duration) {
+        render(surface, size, commits % 2 ? Qt::blue : Qt::red);
+        flush_wayland_connection();
+        commits++;
+
+        next_commit += commit_interval;
+        auto const wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+            next_commit - total.elapsed());
+        QTest::qWait(std::max<int>(wait.count(), 0));
+    }
+
+    auto const elapsed = total.elapsed();
+    auto const allocations = total.allocations();
+
+    add_result(name, "commits", commits);
+    add_result(name, "total_ms", to_ms(elapsed));
+    add_result(name, "allocations", allocations);
+    add_frame_statistics(name, output.telemetry);
+
+    if (output.telemetry.paint.count) {
+        add_result(name,
+                   "allocations_per_frame",
+                   static_cast<double>(allocations) / output.telemetry.paint.count);
+    }
+
+    toplevel.reset();
+    surface.reset();
+    destroy_wayland_connection();
+}
+
+}
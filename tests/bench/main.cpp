@@ -0,0 +1,49 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "report.h"
+
+#include "../integration/lib/helpers.h"
+#include "como/base/wayland/app_singleton.h"
+
+#include <KCrash>
+#include <QApplication>
+#include <catch2/catch_session.hpp>
+
+int main(int argc, char* argv[])
+{
+    KCrash::setDrKonqiEnabled(false);
+    KLocalizedString::setApplicationDomain("kwin");
+
+    como::detail::test::prepare_app_env(argv[0]);
+
+    como::base::wayland::app_singleton app(argc, argv);
+
+    auto const own_path = app.qapp->libraryPaths().constLast();
+    app.qapp->removeLibraryPath(own_path);
+    app.qapp->addLibraryPath(own_path);
+
+    Catch::Session session;
+    std::string output_path;
+
+    using Catch::Clara::Opt;
+    session.cli(session.cli()
+                | Opt(output_path, "path")["--bench-output"](
+                    "file to write the results to as JSON, stdout if not set"));
+
+    if (auto const ret = session.applyCommandLine(argc, argv); ret != 0) {
+        return ret;
+    }
+
+    auto const ret = session.run();
+
+    if (!como::detail::test::bench::write_report(output_path)) {
+        return 1;
+    }
+
+    return ret;
+}
@@ -0,0 +1,61 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "scenario.h"
+
+#include <Wrapland/Client/surface.h>
+#include <Wrapland/Client/xdg_shell.h>
+
+namespace como::detail::test::bench
+{
+
+TEST_CASE("map windows", "[bench]")
+{
+    std::string const name{"map-windows"};
+    constexpr int window_count{50};
+
+    auto setup = create_setup("bench-" + name);
+    setup_wayland_connection();
+
+    std::vector<std::unique_ptr<Wrapland::Client::Surface>> surfaces;
+    std::vector<std::unique_ptr<Wrapland::Client::XdgShellToplevel>> toplevels;
+
+    auto& output = get_render_output(*setup);
+    output.telemetry.reset();
+
+    measurement total;
+    std::chrono::nanoseconds map_max{0};
+
+    for (int i = 0; i < window_count; i++) {
+        auto surface = create_surface();
+        auto toplevel = create_xdg_shell_toplevel(surface);
+        REQUIRE(toplevel);
+
+        measurement map;
+        auto window = render_and_wait_for_shown(surface, QSize(400, 300), Qt::blue);
+        REQUIRE(window);
+        map_max = std::max(map_max, map.elapsed());
+
+        surfaces.push_back(std::move(surface));
+        toplevels.push_back(std::move(toplevel));
+    }
+
+    auto const elapsed = total.elapsed();
+    auto const allocations = total.allocations();
+
+    add_result(name, "windows", window_count);
+    add_result(name, "map_total_ms", to_ms(elapsed));
+    add_result(name, "map_avg_ms", to_ms(elapsed / window_count));
+    add_result(name, "map_max_ms", to_ms(map_max));
+    add_result(name, "allocations", allocations);
+    add_result(name, "allocations_per_window", static_cast<double>(allocations) / window_count);
+    add_frame_statistics(name, output.telemetry);
+
+    toplevels.clear();
+    surfaces.clear();
+    destroy_wayland_connection();
+}
+
+}
@@ -0,0 +1,84 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "scenario.h"
+
+#include "como/win/move.h"
+
+#include <Wrapland/Client/surface.h>
+#include <Wrapland/Client/xdg_shell.h>
+#include <algorithm>
+
+namespace como::detail::test::bench
+{
+
+TEST_CASE("pointer sweep", "[bench]")
+{
+    std::string const name{"pointer-sweep"};
+    constexpr int window_count{20};
+    constexpr int step{8};
+
+    auto setup = create_setup("bench-" + name);
+    setup_wayland_connection(global_selection::seat);
+    REQUIRE(wait_for_wayland_pointer());
+
+    std::vector<std::unique_ptr<Wrapland::Client::Surface>> surfaces;
+    std::vector<std::unique_ptr<Wrapland::Client::XdgShellToplevel>> toplevels;
+
+    // Windows overlap each other diagonally so most positions hit several window geometries.
+    for (int i = 0; i < window_count; i++) {
+        auto surface = create_surface();
+        auto toplevel = create_xdg_shell_toplevel(surface);
+        REQUIRE(toplevel);
+
+        auto window = render_and_wait_for_shown(surface, QSize(400, 300), Qt::blue);
+        REQUIRE(window);
+        win::move(window, QPoint(i * 40, i * 35));
+
+        surfaces.push_back(std::move(surface));
+        toplevels.push_back(std::move(toplevel));
+    }
+
+    auto const size = setup->base->topology.size;
+    std::vector<std::chrono::nanoseconds> latencies;
+    latencies.reserve((size.width() / step + 1) * (size.height() / step + 1));
+
+    uint32_t timestamp{1};
+    auto& output = get_render_output(*setup);
+    output.telemetry.reset();
+
+    measurement total;
+
+    for (int y = 0; y < size.height(); y += step) {
+        for (int x = 0; x < size.width(); x += step) {
+            measurement event;
+            pointer_motion_absolute(QPointF(x, y), timestamp++);
+            latencies.push_back(event.elapsed());
+        }
+        QCoreApplication::processEvents();
+    }
+
+    auto const elapsed = total.elapsed();
+    auto const allocations = total.allocations();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto const events = static_cast<int64_t>(latencies.size());
+    REQUIRE(events > 0);
+
+    add_result(name, "windows", window_count);
+    add_result(name, "events", events);
+    add_result(name, "total_ms", to_ms(elapsed));
+    add_result(name, "dispatch_avg_ms", to_ms(elapsed / events));
+    add_result(name, "dispatch_p99_ms", to_ms(latencies.at(events * 99 / 100)));
+    add_result(name, "dispatch_max_ms", to_ms(latencies.back()));
+    add_result(name, "allocations_per_event", static_cast<double>(allocations) / events);
+    add_frame_statistics(name, output.telemetry);
+
+    toplevels.clear();
+    surfaces.clear();
+    destroy_wayland_connection();
+}
+
+}
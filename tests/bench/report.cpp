@@ -0,0 +1,81 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "report.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <iostream>
+#include <map>
+
+namespace como::detail::test::bench
+{
+
+static std::map<std::string, std::map<std::string, double>>& results()
+{
+    static std::map<std::string, std::map<std::string, double>> results;
+    return results;
+}
+
+void add_result(std::string const& scenario, std::string const& metric, double value)
+{
+    results()[scenario][metric] = value;
+}
+
+void add_frame_statistics(std::string const& scenario,
+                          render::wayland::output_telemetry const& telemetry)
+{
+    auto const& prepare = telemetry.prepare;
+    auto const& paint = telemetry.paint;
+
+    add_result(scenario, "frames", paint.count);
+
+    if (prepare.count) {
+        auto const runs = static_cast<int64_t>(prepare.count);
+        add_result(scenario, "prepare_avg_ms", to_ms(prepare.total / runs));
+        add_result(scenario, "prepare_max_ms", to_ms(prepare.max));
+    }
+    if (paint.count) {
+        auto const frames = static_cast<int64_t>(paint.count);
+        add_result(scenario, "paint_avg_ms", to_ms(paint.total / frames));
+        add_result(scenario, "paint_max_ms", to_ms(paint.max));
+    }
+}
+
+bool write_report(std::string const& path)
+{
+    QJsonObject scenarios;
+
+    for (auto const& [scenario, metrics] : results()) {
+        QJsonObject values;
+        for (auto const& [metric, value] : metrics) {
+            values.insert(QString::fromStdString(metric), value);
+        }
+        scenarios.insert(QString::fromStdString(scenario), values);
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("version"), 1);
+    root.insert(QStringLiteral("scenarios"), scenarios);
+
+    auto const json = QJsonDocument(root).toJson();
+
+    if (path.empty()) {
+        std::cout << json.constData();
+        return true;
+    }
+
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::cerr << "Could not open benchmark output file: " << path << std::endl;
+        return false;
+    }
+
+    file.write(json);
+    return true;
+}
+
+}
@@ -0,0 +1,59 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "allocations.h"
+
+#include "como/render/wayland/output_telemetry.h"
+
+#include <QElapsedTimer>
+#include <chrono>
+#include <string>
+
+namespace como::detail::test::bench
+{
+
+/// Adds a result @p value for @p metric of @p scenario to the report.
+void add_result(std::string const& scenario, std::string const& metric, double value);
+
+/// Adds the frame statistics from the telemetry of an output to the results of @p scenario.
+void add_frame_statistics(std::string const& scenario,
+                          render::wayland::output_telemetry const& telemetry);
+
+/// Writes all results as JSON to the file at @p path or to stdout if @p path is empty.
+bool write_report(std::string const& path);
+
+/// Measures time and allocations from its creation on.
+class measurement
+{
+public:
+    measurement()
+        : allocations_start{allocation_count()}
+    {
+        timer.start();
+    }
+
+    std::chrono::nanoseconds elapsed() const
+    {
+        return std::chrono::nanoseconds(timer.nsecsElapsed());
+    }
+
+    uint64_t allocations() const
+    {
+        return allocation_count() - allocations_start;
+    }
+
+private:
+    QElapsedTimer timer;
+    uint64_t allocations_start;
+};
+
+inline double to_ms(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+}
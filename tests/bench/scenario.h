@@ -0,0 +1,49 @@
+/*
+    SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#pragma once
+
+#include "../integration/lib/setup.h"
+
+#include "report.h"
+
+namespace como::detail::test::bench
+{
+
+/**
+ * Starts a compositor with a single output, OpenGL compositing and all effects disabled, such that
+ * results do not depend on the configuration of the host.
+ */
+inline std::unique_ptr<setup> create_setup(std::string const& name)
+{
+    qputenv("XCURSOR_THEME", QByteArrayLiteral("DMZ-White"));
+    qputenv("XCURSOR_SIZE", QByteArrayLiteral("24"));
+    qputenv("KWIN_COMPOSE", QByteArrayLiteral("O2"));
+
+    auto setup = std::make_unique<test::setup>(name);
+
+    auto config = setup->base->config.main;
+    KConfigGroup plugins(config, QStringLiteral("Plugins"));
+    auto const builtin_names = render::effect_loader(*setup->base->mod.render).listOfKnownEffects();
+
+    for (auto const& effect : builtin_names) {
+        plugins.writeEntry(effect + QStringLiteral("Enabled"), false);
+    }
+
+    config->sync();
+    setup->start();
+
+    REQUIRE(setup->base->mod.render->scene);
+    REQUIRE(setup->base->mod.render->scene->isOpenGl());
+
+    return setup;
+}
+
+inline auto& get_render_output(setup& setup)
+{
+    return *setup.base->outputs.at(0)->render;
+}
+
+}
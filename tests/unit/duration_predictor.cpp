@@ -0,0 +1,96 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/render/wayland/duration_predictor.h"
+
+using namespace std::chrono_literals;
+
+namespace como::detail::test
+{
+
+TEST_CASE("duration predictor", "[render],[unit]")
+{
+    using render::wayland::duration_histogram;
+    using render::wayland::duration_prediction_policy;
+    using render::wayland::duration_predictor;
+
+    SECTION("empty histogram")
+    {
+        duration_histogram histogram;
+        REQUIRE(histogram.get_percentile(0.99) == 0ns);
+    }
+
+    SECTION("constant durations")
+    {
+        duration_histogram histogram;
+        for (int i = 0; i < 200; i++) {
+            histogram.update(1100us);
+        }
+
+        REQUIRE(histogram.get_percentile(0.5) == 1250us);
+        REQUIRE(histogram.get_percentile(0.99) == 1250us);
+    }
+
+    SECTION("single hitch is ignored by percentiles")
+    {
+        duration_predictor predictor;
+
+        for (int i = 0; i < 200; i++) {
+            predictor.update(1ms);
+        }
+        predictor.update(10ms);
+        predictor.update(1ms);
+
+        predictor.policy = duration_prediction_policy::max;
+        REQUIRE(predictor.predict() == 10ms);
+
+        predictor.policy = duration_prediction_policy::p99;
+        REQUIRE(predictor.predict() == 1250us);
+
+        predictor.policy = duration_prediction_policy::p95;
+        REQUIRE(predictor.predict() == 1250us);
+    }
+
+    SECTION("frequent hitches are predicted")
+    {
+        duration_predictor predictor;
+        predictor.policy = duration_prediction_policy::p99;
+
+        for (int i = 0; i < 400; i++) {
+            predictor.update(i % 10 ? 1ms : 5ms);
+        }
+
+        REQUIRE(predictor.predict() == 5250us);
+    }
+
+    SECTION("old values decay")
+    {
+        duration_histogram histogram;
+
+        for (int i = 0; i < 200; i++) {
+            histogram.update(8ms);
+        }
+        REQUIRE(histogram.get_percentile(0.5) == 8250us);
+
+        for (int i = 0; i < 1000; i++) {
+            histogram.update(2ms);
+        }
+        REQUIRE(histogram.get_percentile(0.99) == 2250us);
+    }
+
+    SECTION("overflow")
+    {
+        duration_histogram histogram;
+
+        for (int i = 0; i < 10; i++) {
+            histogram.update(100ms);
+        }
+        REQUIRE(histogram.get_percentile(0.99) == 100ms);
+    }
+}
+
+}
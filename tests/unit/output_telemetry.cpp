@@ -0,0 +1,93 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/render/wayland/output_telemetry.h"
+
+using namespace std::chrono_literals;
+
+namespace como::detail::test
+{
+
+TEST_CASE("output telemetry", "[render],[unit]")
+{
+    using render::wayland::output_telemetry;
+
+    output_telemetry telemetry;
+
+    SECTION("schedule delay")
+    {
+        telemetry.scheduled_run(10ms);
+        REQUIRE(telemetry.schedule_delay.count == 0);
+
+        telemetry.planned_run = 10ms;
+        telemetry.scheduled_run(12ms);
+        REQUIRE(telemetry.schedule_delay.count == 1);
+        REQUIRE(telemetry.schedule_delay.last == 2ms);
+        REQUIRE(!telemetry.planned_run);
+
+        // Only one delay is recorded per planned run.
+        telemetry.scheduled_run(20ms);
+        REQUIRE(telemetry.schedule_delay.count == 1);
+    }
+
+    SECTION("presentation without submission")
+    {
+        telemetry.presented(10ms, 16ms);
+        REQUIRE(telemetry.presented_frames == 0);
+        REQUIRE(telemetry.presentation_latency.count == 0);
+    }
+
+    SECTION("presented in time")
+    {
+        telemetry.submitted(100ms);
+        telemetry.presented(110ms, 16ms);
+
+        REQUIRE(telemetry.presented_frames == 1);
+        REQUIRE(telemetry.presentation_latency.last == 10ms);
+        REQUIRE(telemetry.missed_vblanks == 0);
+    }
+
+    SECTION("missed vblanks")
+    {
+        telemetry.submitted(100ms);
+        telemetry.presented(140ms, 16ms);
+
+        REQUIRE(telemetry.presented_frames == 1);
+        REQUIRE(telemetry.missed_vblanks == 2);
+
+        // The feedback of the same frame is only counted once.
+        telemetry.presented(156ms, 16ms);
+        REQUIRE(telemetry.presented_frames == 1);
+        REQUIRE(telemetry.missed_vblanks == 2);
+    }
+
+    SECTION("durations")
+    {
+        telemetry.paint.update(3ms);
+        telemetry.paint.update(5ms);
+
+        REQUIRE(telemetry.paint.count == 2);
+        REQUIRE(telemetry.paint.last == 5ms);
+        REQUIRE(telemetry.paint.total == 8ms);
+        REQUIRE(telemetry.paint.max == 5ms);
+    }
+
+    SECTION("reset")
+    {
+        telemetry.paint.update(3ms);
+        telemetry.submitted(100ms);
+        telemetry.presented(140ms, 16ms);
+        telemetry.reset();
+
+        REQUIRE(telemetry.paint.count == 0);
+        REQUIRE(telemetry.paint.max == 0ns);
+        REQUIRE(telemetry.presented_frames == 0);
+        REQUIRE(telemetry.missed_vblanks == 0);
+    }
+}
+
+}
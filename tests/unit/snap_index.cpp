@@ -0,0 +1,49 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/win/snap_index.h"
+
+#include <vector>
+
+namespace como::detail::test
+{
+
+TEST_CASE("snap index", "[win],[unit]")
+{
+    using indices_t = std::vector<size_t>;
+
+    win::snap_index index(
+        {QRect(0, 0, 100, 100), QRect(500, 500, 100, 100), QRect(95, 300, 10, 10)});
+
+    SECTION("empty")
+    {
+        win::snap_index empty;
+        REQUIRE(empty.windows().empty());
+        REQUIRE(empty.query({0, 0}, {0, 0}, 10).empty());
+    }
+
+    SECTION("vertical edges")
+    {
+        // Right edge of the first and left edge of the third window.
+        REQUIRE(index.query({100, 2000}, {2000, 2000}, 5) == indices_t{0, 2});
+        REQUIRE(index.query({100, 2000}, {2000, 2000}, 4) == indices_t{0});
+    }
+
+    SECTION("horizontal edges")
+    {
+        REQUIRE(index.query({2000, 2000}, {600, 2000}, 0) == indices_t{1});
+        REQUIRE(index.query({2000, 2000}, {599, 2000}, 0).empty());
+    }
+
+    SECTION("ascending without duplicates")
+    {
+        REQUIRE(index.query({600, 0}, {0, 500}, 10) == indices_t{0, 1});
+        REQUIRE(index.windows().at(1) == QRect(500, 500, 100, 100));
+    }
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/xwl/transfer_buffer.h"
+
+#include <cstring>
+#include <string>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+void write(xwl::transfer_buffer& buffer, std::string const& data)
+{
+    auto space = buffer.write_space();
+    REQUIRE(space.size() >= data.size());
+    std::memcpy(space.data(), data.data(), data.size());
+    buffer.commit(data.size());
+}
+
+std::string read(xwl::transfer_buffer& buffer, size_t max_size)
+{
+    auto data = buffer.read_space(max_size);
+    std::string result(data.data(), data.size());
+    buffer.consume(data.size());
+    return result;
+}
+
+}
+
+TEST_CASE("transfer buffer", "[xwl],[unit]")
+{
+    xwl::transfer_buffer buffer(8);
+
+    REQUIRE(buffer.empty());
+    REQUIRE(buffer.read_space(8).empty());
+
+    SECTION("fill and drain")
+    {
+        write(buffer, "abcdefgh");
+        REQUIRE(buffer.full());
+        REQUIRE(buffer.write_space().empty());
+
+        REQUIRE(read(buffer, 3) == "abc");
+        REQUIRE(buffer.size() == 5);
+        REQUIRE(read(buffer, 8) == "defgh");
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("wrap around")
+    {
+        write(buffer, "abcdef");
+        REQUIRE(read(buffer, 4) == "abcd");
+
+        // Free space at the end first, then at the front.
+        REQUIRE(buffer.write_space().size() == 2);
+        write(buffer, "gh");
+        REQUIRE(buffer.write_space().size() == 4);
+        write(buffer, "ijkl");
+        REQUIRE(buffer.full());
+
+        // Reads are contiguous and stop at the end of the storage.
+        REQUIRE(read(buffer, 8) == "efgh");
+        REQUIRE(read(buffer, 8) == "ijkl");
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("restart at front when drained")
+    {
+        write(buffer, "abc");
+        REQUIRE(read(buffer, 8) == "abc");
+        REQUIRE(buffer.write_space().size() == 8);
+    }
+}
+
+}
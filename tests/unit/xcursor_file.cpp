@@ -0,0 +1,176 @@
+/*
+SPDX-FileCopyrightText: 2026 Roman Gilg <subdiff@gmail.com>
+
+SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#include "../integration/lib/catch_macros.h"
+
+#include "como/input/wayland/xcursor_theme.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtEndian>
+#include <cstdint>
+#include <vector>
+
+namespace como::detail::test
+{
+
+namespace
+{
+
+constexpr uint32_t magic{0x72756358};
+constexpr uint32_t image_type{0xfffd0002};
+constexpr uint32_t file_header_size{4 * 4};
+constexpr uint32_t toc_size{3 * 4};
+constexpr uint32_t image_header_size{9 * 4};
+
+struct image {
+    uint32_t nominal{24};
+    uint32_t width{2};
+    uint32_t height{2};
+    uint32_t xhot{1};
+    uint32_t yhot{1};
+    uint32_t delay{50};
+};
+
+void append(QByteArray& data, uint32_t value)
+{
+    char bytes[4];
+    qToLittleEndian(value, bytes);
+    data.append(bytes, 4);
+}
+
+QByteArray file_header(uint32_t ntoc)
+{
+    QByteArray data;
+    append(data, magic);
+    append(data, file_header_size);
+    append(data, 0x10000);
+    append(data, ntoc);
+    return data;
+}
+
+/// An Xcursor file with one image chunk per entry of @p images.
+QByteArray cursor_file(std::vector<image> const& images)
+{
+    auto const count = static_cast<uint32_t>(images.size());
+    auto data = file_header(count);
+
+    auto position = file_header_size + count * toc_size;
+    for (auto const& img : images) {
+        append(data, image_type);
+        append(data, img.nominal);
+        append(data, position);
+        position += image_header_size + img.width * img.height * 4;
+    }
+
+    for (auto const& img : images) {
+        append(data, image_header_size);
+        append(data, image_type);
+        append(data, img.nominal);
+        append(data, 1);
+        append(data, img.width);
+        append(data, img.height);
+        append(data, img.xhot);
+        append(data, img.yhot);
+        append(data, img.delay);
+
+        for (uint32_t pixel = 0; pixel < img.width * img.height; ++pixel) {
+            append(data, 0xff000000 | pixel);
+        }
+    }
+
+    return data;
+}
+
+QList<input::wayland::xcursor_sprite> load(QByteArray const& data, int size = 24)
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    auto const path = dir.filePath(QStringLiteral("cursor"));
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    REQUIRE(file.write(data) == data.size());
+    file.close();
+
+    return input::wayland::load_xcursor_file(path, size, 1.);
+}
+
+}
+
+TEST_CASE("xcursor file", "[input],[unit]")
+{
+    SECTION("valid")
+    {
+        auto const sprites = load(cursor_file({image{}}));
+        REQUIRE(sprites.size() == 1);
+
+        auto const& sprite = sprites.front();
+        REQUIRE(sprite.data().size() == QSize(2, 2));
+        REQUIRE(sprite.hotspot() == QPoint(1, 1));
+        REQUIRE(sprite.delay() == std::chrono::milliseconds(50));
+        REQUIRE(sprite.data().pixel(1, 1) == 0xff000003);
+    }
+
+    SECTION("closest nominal size")
+    {
+        auto const sprites = load(cursor_file({image{.nominal = 24, .width = 1, .height = 1},
+                                               image{.nominal = 48, .width = 2, .height = 2},
+                                               image{.nominal = 48, .width = 2, .height = 2}}),
+                                  40);
+        REQUIRE(sprites.size() == 2);
+        REQUIRE(sprites.front().data().size() == QSize(2, 2));
+    }
+
+    SECTION("truncated header")
+    {
+        REQUIRE(load(file_header(1).left(file_header_size - 1)).isEmpty());
+    }
+
+    SECTION("wrong magic")
+    {
+        auto data = cursor_file({image{}});
+        data[0] = 0;
+        REQUIRE(load(data).isEmpty());
+    }
+
+    SECTION("table of contents overflows file")
+    {
+        auto data = cursor_file({image{}});
+        qToLittleEndian<uint32_t>(0x10000000, data.data() + 12);
+        REQUIRE(load(data).isEmpty());
+    }
+
+    SECTION("image chunk past end of file")
+    {
+        auto data = cursor_file({image{}});
+        auto const position = file_header_size + 8;
+
+        qToLittleEndian<uint32_t>(data.size() + 4, data.data() + position);
+        REQUIRE(load(data).isEmpty());
+
+        qToLittleEndian<uint32_t>(data.size() - image_header_size + 4, data.data() + position);
+        REQUIRE(load(data).isEmpty());
+    }
+
+    SECTION("image pixels past end of file")
+    {
+        auto const data = cursor_file({image{}});
+        REQUIRE(load(data.left(data.size() - 1)).isEmpty());
+    }
+
+    SECTION("hotspot outside of image")
+    {
+        REQUIRE(load(cursor_file({image{.xhot = 3}})).isEmpty());
+        REQUIRE(load(cursor_file({image{.yhot = 3}})).isEmpty());
+    }
+
+    SECTION("corrupt frame discards cursor")
+    {
+        REQUIRE(load(cursor_file({image{}, image{.xhot = 3}})).isEmpty());
+    }
+}
+
+}